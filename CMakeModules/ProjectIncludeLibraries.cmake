@@ -323,6 +323,23 @@ if(WITH_BONJOUR)
 	endif(Bonjour_FOUND)
 endif(WITH_BONJOUR)
 
+#####################
+### Compression
+#####################
+
+# Add zlib, used by the service resources to compress the requests and decode the responses
+find_package (ZLIB QUIET)
+option(SOAPERO_WITH_ZLIB "Enable build with zlib library" ${ZLIB_FOUND})
+if(SOAPERO_WITH_ZLIB)
+	find_package (ZLIB REQUIRED)
+	include_directories (${ZLIB_INCLUDE_DIRS})
+	add_definitions(-DSOAPERO_WITH_ZLIB)
+	set(SOAPERO_ZLIB_LIBRARIES ${ZLIB_LIBRARIES})
+	if(NOT AUTONOMOUS_PACKAGE_BUILD)
+		list(APPEND PACKAGE_DEPS "zlib1g")
+	endif()
+endif(SOAPERO_WITH_ZLIB)
+
 #####################
 ### Mux/Demux modules
 #####################
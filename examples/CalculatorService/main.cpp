@@ -1,6 +1,9 @@
 #include <QCoreApplication>
 
 #include "calculator/CalculatorService.h"
+#include "calculator/PooledQueryExecutor.h"
+#include "calculator/RecordingQueryExecutor.h"
+#include "calculator/ReplayQueryExecutor.h"
 
 int main(int argc, char** argv)
 {
@@ -9,7 +12,7 @@ int main(int argc, char** argv)
 	printf("Starting application\n");
 
 	if(argc<3){
-		printf("Usage: A B\n");
+		printf("Usage: A B [--url=URL] [--record=DIR] [--replay=DIR]\n");
 		return 0;
 	}
 
@@ -20,6 +23,20 @@ int main(int argc, char** argv)
 	service.setBaseUrl(QUrl("http://www.dneonline.com/calculator.asmx"));
 	service.setDebug(true);
 
+	for(int i = 3; i < argc; ++i) {
+		QString szArg = argv[i];
+		if(szArg.startsWith("--url=")){
+			service.setBaseUrl(QUrl(szArg.mid(6)));
+		}
+		// Record the queries to replay them later without the service
+		if(szArg.startsWith("--record=")){
+			service.setQueryExecutor(new calculator::RecordingQueryExecutor(new calculator::PooledQueryExecutor(), szArg.mid(9)));
+		}
+		if(szArg.startsWith("--replay=")){
+			service.setQueryExecutor(new calculator::ReplayQueryExecutor(szArg.mid(9)));
+		}
+	}
+
 	XS::Integer iA;
 	iA.setValue(szArg1.toInt());
 	XS::Integer iB;
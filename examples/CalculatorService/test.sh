@@ -1,6 +1,10 @@
+# Set SOAP_URL to test another endpoint. These hand-written envelopes do not match
+# the queries recorded for the ReplayServer example, use "CalculatorService A B --url=URL" for it.
+SOAP_URL=${SOAP_URL:-http://www.dneonline.com/calculator.asmx}
+
 echo "Test divide:"
 
-curl --location --request POST 'http://www.dneonline.com/calculator.asmx' \
+curl --location --request POST "${SOAP_URL}" \
 --header 'Content-Type: text/xml; charset=utf-8' \
 --header 'SOAPAction: http://tempuri.org/Divide' \
 --data-raw '<?xml version="1.0" encoding="utf-8"?>
@@ -15,7 +19,7 @@ curl --location --request POST 'http://www.dneonline.com/calculator.asmx' \
 
 echo "Test add:"
 
-curl --location --request POST 'http://www.dneonline.com/calculator.asmx' \
+curl --location --request POST "${SOAP_URL}" \
 --header 'Content-Type: text/xml; charset=utf-8' \
 --header 'SOAPAction: http://tempuri.org/Add' \
 --data-raw '<?xml version="1.0" encoding="utf-8"?>
@@ -0,0 +1,182 @@
+#include <QCoreApplication>
+#include <QHash>
+#include <QSharedPointer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include "QueryRecording.h"
+
+using namespace SOAPERO;
+
+// Loopback HTTP server answering the SOAP queries with the responses of a recording
+// made by RecordingQueryExecutor, to run or load test a client without the real service.
+
+struct HttpRequest
+{
+	QByteArray method;
+	QByteArray version;
+	QHash<QByteArray, QByteArray> headers; // Lower case names
+	QByteArray body;
+};
+
+struct Connection
+{
+	QByteArray buffer;
+	bool bBusy;
+};
+
+static QueryRecording* g_pRecording = NULL;
+static double g_fLatencyFactor = 0.0;
+
+// Extract the first complete request of the buffer
+static bool parseRequest(QByteArray& buffer, HttpRequest& request)
+{
+	int iHeaderEnd = buffer.indexOf("\r\n\r\n");
+	if(iHeaderEnd < 0) {
+		return false;
+	}
+
+	QList<QByteArray> listLines = buffer.left(iHeaderEnd).split('\n');
+	QList<QByteArray> listRequestLine = listLines.takeFirst().trimmed().split(' ');
+	request.method = listRequestLine.value(0);
+	request.version = listRequestLine.value(2);
+	request.headers.clear();
+	foreach(const QByteArray& line, listLines) {
+		int iSep = line.indexOf(':');
+		if(iSep > 0) {
+			request.headers.insert(line.left(iSep).trimmed().toLower(), line.mid(iSep + 1).trimmed());
+		}
+	}
+
+	int iContentLength = request.headers.value("content-length").toInt();
+	int iBodyStart = iHeaderEnd + 4;
+	if(buffer.size() < iBodyStart + iContentLength) {
+		return false;
+	}
+	request.body = buffer.mid(iBodyStart, iContentLength);
+	buffer.remove(0, iBodyStart + iContentLength);
+	return true;
+}
+
+static QByteArray getReasonPhrase(int iStatusCode)
+{
+	switch(iStatusCode) {
+	case 200: return "OK";
+	case 400: return "Bad Request";
+	case 404: return "Not Found";
+	case 405: return "Method Not Allowed";
+	case 500: return "Internal Server Error";
+	case 502: return "Bad Gateway";
+	default: return "Status";
+	}
+}
+
+static QByteArray buildResponse(int iStatusCode, const QByteArray& contentType, const QByteArray& body, bool bKeepAlive)
+{
+	QByteArray response;
+	response += "HTTP/1.1 " + QByteArray::number(iStatusCode) + " " + getReasonPhrase(iStatusCode) + "\r\n";
+	response += "Content-Type: " + contentType + "\r\n";
+	response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+	response += (bKeepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n");
+	response += "\r\n";
+	response += body;
+	return response;
+}
+
+// Answer the requests of the connection one at a time, in order
+static void processRequests(QTcpSocket* pSocket, QSharedPointer<Connection> pConnection)
+{
+	HttpRequest request;
+	if(pConnection->bBusy || !parseRequest(pConnection->buffer, request)) {
+		return;
+	}
+
+	QByteArray connection = request.headers.value("connection").toLower();
+	bool bKeepAlive = (request.version == "HTTP/1.0" ? connection == "keep-alive" : connection != "close");
+
+	// SOAP 1.1 responses use the type of the request, SOAP 1.2 carry the action in it
+	QByteArray contentType = request.headers.value("content-type", "text/xml").split(';').first().trimmed();
+	contentType += "; charset=utf-8";
+
+	int iStatusCode;
+	QByteArray body;
+	int iLatency = 0;
+	QueryRecording::Query query;
+	if(request.method != "POST") {
+		iStatusCode = 405;
+	}else{
+		QByteArray key = QueryRecording::buildKey(request.headers.value("soapaction"), request.headers.value("content-encoding"), request.body);
+		if(g_pRecording->findQuery(key, query)) {
+			// A network error was recorded
+			iStatusCode = (query.iHttpStatusCode > 0 ? query.iHttpStatusCode : 502);
+			body = query.response;
+			iLatency = (int)(query.iLatency * g_fLatencyFactor);
+		}else{
+			printf("No recorded response for %s\n", request.headers.value("soapaction").constData());
+			iStatusCode = 404;
+		}
+	}
+
+	pConnection->bBusy = true;
+	QTimer::singleShot(iLatency, pSocket, [=]() {
+		pSocket->write(buildResponse(iStatusCode, contentType, body, bKeepAlive));
+		pConnection->bBusy = false;
+		if(bKeepAlive) {
+			processRequests(pSocket, pConnection);
+		}else{
+			pSocket->disconnectFromHost();
+		}
+	});
+}
+
+int main(int argc, char** argv)
+{
+	QCoreApplication app(argc, argv);
+
+	if(argc < 2){
+		printf("Usage: ReplayServer RECORDING_DIR [--port=PORT] [--latency-factor=FACTOR]\n");
+		printf("       --port=PORT: Port listened on the loopback interface (Default: 8080)\n");
+		printf("       --latency-factor=FACTOR: Factor applied to the recorded latencies (Default: 0)\n");
+		return 0;
+	}
+
+	quint16 iPort = 8080;
+	for(int i = 2; i < argc; ++i) {
+		QString szArg = argv[i];
+		if(szArg.startsWith("--port=")){
+			iPort = szArg.mid(7).toUShort();
+		}
+		if(szArg.startsWith("--latency-factor=")){
+			g_fLatencyFactor = qMax(0.0, szArg.mid(17).toDouble());
+		}
+	}
+
+	QueryRecording recording(argv[1]);
+	if(!recording.load()) {
+		printf("Cannot load the recording %s\n", argv[1]);
+		return 1;
+	}
+	g_pRecording = &recording;
+
+	QTcpServer server;
+	QObject::connect(&server, &QTcpServer::newConnection, [&server]() {
+		while(QTcpSocket* pSocket = server.nextPendingConnection()) {
+			QSharedPointer<Connection> pConnection(new Connection());
+			pConnection->bBusy = false;
+			QObject::connect(pSocket, &QTcpSocket::readyRead, [pSocket, pConnection]() {
+				pConnection->buffer += pSocket->readAll();
+				processRequests(pSocket, pConnection);
+			});
+			QObject::connect(pSocket, &QTcpSocket::disconnected, pSocket, &QObject::deleteLater);
+		}
+	});
+
+	if(!server.listen(QHostAddress::LocalHost, iPort)) {
+		printf("Cannot listen on port %d: %s\n", iPort, qPrintable(server.errorString()));
+		return 1;
+	}
+	printf("Serving %d recorded queries on http://127.0.0.1:%d/\n", recording.getQueryCount(), iPort);
+
+	return app.exec();
+}
@@ -5,6 +5,8 @@
  *      Author: alavier
  */
 
+#include <utility>
+
 #include "AnySimpleType.h"
 
 namespace XS {
@@ -20,4 +22,30 @@ AnySimpleType::~AnySimpleType()
 
 }
 
+AnySimpleType::AnySimpleType(const AnySimpleType& other)
+	: String(other)
+{
+
+}
+
+AnySimpleType& AnySimpleType::operator=(const AnySimpleType& other)
+{
+	String::operator=(other);
+	return *this;
+}
+
+#ifdef Q_COMPILER_RVALUE_REFS
+AnySimpleType::AnySimpleType(AnySimpleType&& other)
+	: String(std::move(other))
+{
+
+}
+
+AnySimpleType& AnySimpleType::operator=(AnySimpleType&& other)
+{
+	String::operator=(std::move(other));
+	return *this;
+}
+#endif
+
 }
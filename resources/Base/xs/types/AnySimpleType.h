@@ -16,6 +16,12 @@ class AnySimpleType : public String {
 public:
 	AnySimpleType();
 	virtual ~AnySimpleType();
+	AnySimpleType(const AnySimpleType& other);
+	AnySimpleType& operator=(const AnySimpleType& other);
+#ifdef Q_COMPILER_RVALUE_REFS
+	AnySimpleType(AnySimpleType&& other);
+	AnySimpleType& operator=(AnySimpleType&& other);
+#endif
 };
 
 }
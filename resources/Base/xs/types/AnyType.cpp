@@ -5,6 +5,8 @@
  *      Author: alavier
  */
 
+#include <utility>
+
 #include "AnyType.h"
 
 namespace XS {
@@ -20,4 +22,30 @@ AnyType::~AnyType()
 
 }
 
+AnyType::AnyType(const AnyType& other)
+	: String(other)
+{
+
+}
+
+AnyType& AnyType::operator=(const AnyType& other)
+{
+	String::operator=(other);
+	return *this;
+}
+
+#ifdef Q_COMPILER_RVALUE_REFS
+AnyType::AnyType(AnyType&& other)
+	: String(std::move(other))
+{
+
+}
+
+AnyType& AnyType::operator=(AnyType&& other)
+{
+	String::operator=(std::move(other));
+	return *this;
+}
+#endif
+
 }
@@ -16,6 +16,12 @@ class AnyType : public String {
 public:
 	AnyType();
 	virtual ~AnyType();
+	AnyType(const AnyType& other);
+	AnyType& operator=(const AnyType& other);
+#ifdef Q_COMPILER_RVALUE_REFS
+	AnyType(AnyType&& other);
+	AnyType& operator=(AnyType&& other);
+#endif
 };
 
 }
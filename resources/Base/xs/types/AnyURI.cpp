@@ -5,6 +5,8 @@
  *      Author: alavier
  */
 
+#include <utility>
+
 #include "AnyURI.h"
 
 namespace XS {
@@ -20,4 +22,30 @@ AnyURI::~AnyURI()
 
 }
 
+AnyURI::AnyURI(const AnyURI& other)
+	: String(other)
+{
+
+}
+
+AnyURI& AnyURI::operator=(const AnyURI& other)
+{
+	String::operator=(other);
+	return *this;
+}
+
+#ifdef Q_COMPILER_RVALUE_REFS
+AnyURI::AnyURI(AnyURI&& other)
+	: String(std::move(other))
+{
+
+}
+
+AnyURI& AnyURI::operator=(AnyURI&& other)
+{
+	String::operator=(std::move(other));
+	return *this;
+}
+#endif
+
 }
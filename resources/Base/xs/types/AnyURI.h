@@ -16,6 +16,12 @@ class AnyURI : public String {
 public:
 	AnyURI();
 	virtual ~AnyURI();
+	AnyURI(const AnyURI& other);
+	AnyURI& operator=(const AnyURI& other);
+#ifdef Q_COMPILER_RVALUE_REFS
+	AnyURI(AnyURI&& other);
+	AnyURI& operator=(AnyURI&& other);
+#endif
 };
 
 }
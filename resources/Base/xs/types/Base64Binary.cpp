@@ -5,6 +5,8 @@
  *      Author: alavier
  */
 
+#include <utility>
+
 #include "Base64Binary.h"
 
 namespace XS {
@@ -20,4 +22,30 @@ Base64Binary::~Base64Binary()
 
 }
 
+Base64Binary::Base64Binary(const Base64Binary& other)
+	: String(other)
+{
+
+}
+
+Base64Binary& Base64Binary::operator=(const Base64Binary& other)
+{
+	String::operator=(other);
+	return *this;
+}
+
+#ifdef Q_COMPILER_RVALUE_REFS
+Base64Binary::Base64Binary(Base64Binary&& other)
+	: String(std::move(other))
+{
+
+}
+
+Base64Binary& Base64Binary::operator=(Base64Binary&& other)
+{
+	String::operator=(std::move(other));
+	return *this;
+}
+#endif
+
 }
@@ -16,6 +16,12 @@ class Base64Binary : public String {
 public:
 	Base64Binary();
 	virtual ~Base64Binary();
+	Base64Binary(const Base64Binary& other);
+	Base64Binary& operator=(const Base64Binary& other);
+#ifdef Q_COMPILER_RVALUE_REFS
+	Base64Binary(Base64Binary&& other);
+	Base64Binary& operator=(Base64Binary&& other);
+#endif
 };
 
 }
@@ -54,6 +54,25 @@ void Boolean::deserialize(const QDomAttr& attr)
 	}
 }
 
+void Boolean::deserialize(QXmlStreamReader& reader)
+{
+	QString szText = reader.readElementText();
+	if(szText.trimmed() == "true") {
+		setValue(true);
+	}else if(szText.trimmed() == "false"){
+		setValue(false);
+	}
+}
+
+void Boolean::deserialize(const QXmlStreamAttribute& attr)
+{
+	if(attr.value().toString().trimmed() == "true") {
+		setValue(true);
+	}else if(attr.value().toString().trimmed() == "false"){
+		setValue(false);
+	}
+}
+
 bool Boolean::isNull() const
 {
 	return m_bIsNull;
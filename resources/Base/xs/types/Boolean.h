@@ -9,6 +9,7 @@
 #define XS_BOOLEAN_H_
 
 #include <QDomElement>
+#include <QXmlStreamReader>
 #include <QDomAttr>
 #include <QString>
 
@@ -26,6 +27,8 @@ public:
 	QString serialize() const;
 	void deserialize(const QDomElement& element);
 	void deserialize(const QDomAttr& attr);
+	void deserialize(QXmlStreamReader& reader);
+	void deserialize(const QXmlStreamAttribute& attr);
 
 	bool isNull() const;
 
@@ -5,6 +5,8 @@
  *      Author: alavier
  */
 
+#include <utility>
+
 #include "DateTime.h"
 
 namespace XS {
@@ -19,12 +21,48 @@ DateTime::~DateTime()
 
 }
 
+DateTime::DateTime(const DateTime& other)
+	: m_dateTime(other.m_dateTime), m_bIsNull(other.m_bIsNull)
+{
+
+}
+
+DateTime& DateTime::operator=(const DateTime& other)
+{
+	m_dateTime = other.m_dateTime;
+	m_bIsNull = other.m_bIsNull;
+	return *this;
+}
+
+#ifdef Q_COMPILER_RVALUE_REFS
+DateTime::DateTime(DateTime&& other)
+	: m_dateTime(std::move(other.m_dateTime)), m_bIsNull(other.m_bIsNull)
+{
+
+}
+
+DateTime& DateTime::operator=(DateTime&& other)
+{
+	m_dateTime = std::move(other.m_dateTime);
+	m_bIsNull = other.m_bIsNull;
+	return *this;
+}
+#endif
+
 void DateTime::setValue(const QDateTime& dateTime)
 {
 	m_bIsNull = false;
 	m_dateTime = dateTime;
 }
 
+#ifdef Q_COMPILER_RVALUE_REFS
+void DateTime::setValue(QDateTime&& dateTime)
+{
+	m_bIsNull = false;
+	m_dateTime = std::move(dateTime);
+}
+#endif
+
 const QDateTime& DateTime::getValue() const
 {
 	return m_dateTime;
@@ -45,6 +83,17 @@ void DateTime::deserialize(const QDomAttr& attr)
 	setValue(QDateTime::fromString(attr.value(), Qt::ISODate));
 }
 
+void DateTime::deserialize(QXmlStreamReader& reader)
+{
+	QString szText = reader.readElementText();
+	setValue(QDateTime::fromString(szText, Qt::ISODate));
+}
+
+void DateTime::deserialize(const QXmlStreamAttribute& attr)
+{
+	setValue(QDateTime::fromString(attr.value().toString(), Qt::ISODate));
+}
+
 bool DateTime::isNull() const
 {
 	return m_bIsNull;
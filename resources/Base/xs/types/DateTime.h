@@ -9,6 +9,7 @@
 #define XS_DATETIME_H_
 
 #include <QDomElement>
+#include <QXmlStreamReader>
 #include <QDateTime>
 
 namespace XS {
@@ -17,13 +18,24 @@ class DateTime {
 public:
 	DateTime();
 	virtual ~DateTime();
+	DateTime(const DateTime& other);
+	DateTime& operator=(const DateTime& other);
+#ifdef Q_COMPILER_RVALUE_REFS
+	DateTime(DateTime&& other);
+	DateTime& operator=(DateTime&& other);
+#endif
 
 	void setValue(const QDateTime& dateTime);
+#ifdef Q_COMPILER_RVALUE_REFS
+	void setValue(QDateTime&& dateTime);
+#endif
 	const QDateTime& getValue() const;
 
 	QString serialize() const;
 	void deserialize(const QDomElement& element);
 	void deserialize(const QDomAttr& attr);
+	void deserialize(QXmlStreamReader& reader);
+	void deserialize(const QXmlStreamAttribute& attr);
 
 	bool isNull() const;
 
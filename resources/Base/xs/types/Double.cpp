@@ -46,6 +46,17 @@ void Double::deserialize(const QDomAttr& attr)
 	setValue(attr.value().trimmed().toDouble());
 }
 
+void Double::deserialize(QXmlStreamReader& reader)
+{
+	QString szText = reader.readElementText();
+	setValue(szText.trimmed().toDouble());
+}
+
+void Double::deserialize(const QXmlStreamAttribute& attr)
+{
+	setValue(attr.value().toString().trimmed().toDouble());
+}
+
 bool Double::isNull() const
 {
 	return m_bIsNull;
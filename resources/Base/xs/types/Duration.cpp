@@ -5,6 +5,8 @@
  *      Author: lgruber
  */
 
+#include <utility>
+
 #include "Duration.h"
 
 namespace XS {
@@ -19,12 +21,48 @@ Duration::~Duration()
 
 }
 
+Duration::Duration(const Duration& other)
+	: m_szValue(other.m_szValue), m_bIsNull(other.m_bIsNull)
+{
+
+}
+
+Duration& Duration::operator=(const Duration& other)
+{
+	m_szValue = other.m_szValue;
+	m_bIsNull = other.m_bIsNull;
+	return *this;
+}
+
+#ifdef Q_COMPILER_RVALUE_REFS
+Duration::Duration(Duration&& other)
+	: m_szValue(std::move(other.m_szValue)), m_bIsNull(other.m_bIsNull)
+{
+
+}
+
+Duration& Duration::operator=(Duration&& other)
+{
+	m_szValue = std::move(other.m_szValue);
+	m_bIsNull = other.m_bIsNull;
+	return *this;
+}
+#endif
+
 void Duration::setValue(const QString& szValue)
 {
 	m_bIsNull = false;
 	m_szValue = szValue;
 }
 
+#ifdef Q_COMPILER_RVALUE_REFS
+void Duration::setValue(QString&& szValue)
+{
+	m_bIsNull = false;
+	m_szValue = std::move(szValue);
+}
+#endif
+
 const QString& Duration::getValue() const
 {
 	return m_szValue;
@@ -45,6 +83,17 @@ void Duration::deserialize(const QDomAttr& attr)
 	setValue(attr.value().trimmed());
 }
 
+void Duration::deserialize(QXmlStreamReader& reader)
+{
+	QString szText = reader.readElementText();
+	setValue(szText.trimmed());
+}
+
+void Duration::deserialize(const QXmlStreamAttribute& attr)
+{
+	setValue(attr.value().toString().trimmed());
+}
+
 bool Duration::isNull() const
 {
 	return m_bIsNull;
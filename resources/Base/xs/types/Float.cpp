@@ -46,6 +46,17 @@ void Float::deserialize(const QDomAttr& attr)
 	setValue(attr.value().trimmed().toFloat());
 }
 
+void Float::deserialize(QXmlStreamReader& reader)
+{
+	QString szText = reader.readElementText();
+	setValue(szText.trimmed().toFloat());
+}
+
+void Float::deserialize(const QXmlStreamAttribute& attr)
+{
+	setValue(attr.value().toString().trimmed().toFloat());
+}
+
 bool Float::isNull() const
 {
 	return m_bIsNull;
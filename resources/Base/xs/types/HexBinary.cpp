@@ -5,6 +5,8 @@
  *      Author: alavier
  */
 
+#include <utility>
+
 #include "HexBinary.h"
 
 namespace XS {
@@ -20,4 +22,30 @@ HexBinary::~HexBinary()
 
 }
 
+HexBinary::HexBinary(const HexBinary& other)
+	: String(other)
+{
+
+}
+
+HexBinary& HexBinary::operator=(const HexBinary& other)
+{
+	String::operator=(other);
+	return *this;
+}
+
+#ifdef Q_COMPILER_RVALUE_REFS
+HexBinary::HexBinary(HexBinary&& other)
+	: String(std::move(other))
+{
+
+}
+
+HexBinary& HexBinary::operator=(HexBinary&& other)
+{
+	String::operator=(std::move(other));
+	return *this;
+}
+#endif
+
 }
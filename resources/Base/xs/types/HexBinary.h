@@ -16,6 +16,12 @@ class HexBinary : public String {
 public:
 	HexBinary();
 	virtual ~HexBinary();
+	HexBinary(const HexBinary& other);
+	HexBinary& operator=(const HexBinary& other);
+#ifdef Q_COMPILER_RVALUE_REFS
+	HexBinary(HexBinary&& other);
+	HexBinary& operator=(HexBinary&& other);
+#endif
 };
 
 }
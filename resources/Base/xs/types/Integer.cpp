@@ -46,6 +46,17 @@ void Integer::deserialize(const QDomAttr& attr)
 	setValue(attr.value().trimmed().toInt());
 }
 
+void Integer::deserialize(QXmlStreamReader& reader)
+{
+	QString szText = reader.readElementText();
+	setValue(szText.trimmed().toInt());
+}
+
+void Integer::deserialize(const QXmlStreamAttribute& attr)
+{
+	setValue(attr.value().toString().trimmed().toInt());
+}
+
 bool Integer::isNull() const
 {
 	return m_bIsNull;
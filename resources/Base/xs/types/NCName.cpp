@@ -5,6 +5,8 @@
  *      Author: alavier
  */
 
+#include <utility>
+
 #include "NCName.h"
 
 namespace XS {
@@ -20,4 +22,30 @@ NCName::~NCName()
 
 }
 
+NCName::NCName(const NCName& other)
+	: String(other)
+{
+
+}
+
+NCName& NCName::operator=(const NCName& other)
+{
+	String::operator=(other);
+	return *this;
+}
+
+#ifdef Q_COMPILER_RVALUE_REFS
+NCName::NCName(NCName&& other)
+	: String(std::move(other))
+{
+
+}
+
+NCName& NCName::operator=(NCName&& other)
+{
+	String::operator=(std::move(other));
+	return *this;
+}
+#endif
+
 }
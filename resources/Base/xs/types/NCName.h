@@ -16,6 +16,12 @@ class NCName : public String {
 public:
 	NCName();
 	virtual ~NCName();
+	NCName(const NCName& other);
+	NCName& operator=(const NCName& other);
+#ifdef Q_COMPILER_RVALUE_REFS
+	NCName(NCName&& other);
+	NCName& operator=(NCName&& other);
+#endif
 };
 
 }
@@ -5,6 +5,8 @@
  *      Author: alavier
  */
 
+#include <utility>
+
 #include "NonNegativeInteger.h"
 
 namespace XS {
@@ -20,4 +22,30 @@ NonNegativeInteger::~NonNegativeInteger()
 
 }
 
+NonNegativeInteger::NonNegativeInteger(const NonNegativeInteger& other)
+	: UnsignedInteger(other)
+{
+
+}
+
+NonNegativeInteger& NonNegativeInteger::operator=(const NonNegativeInteger& other)
+{
+	UnsignedInteger::operator=(other);
+	return *this;
+}
+
+#ifdef Q_COMPILER_RVALUE_REFS
+NonNegativeInteger::NonNegativeInteger(NonNegativeInteger&& other)
+	: UnsignedInteger(std::move(other))
+{
+
+}
+
+NonNegativeInteger& NonNegativeInteger::operator=(NonNegativeInteger&& other)
+{
+	UnsignedInteger::operator=(std::move(other));
+	return *this;
+}
+#endif
+
 }
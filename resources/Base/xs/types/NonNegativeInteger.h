@@ -16,6 +16,12 @@ class NonNegativeInteger : public UnsignedInteger {
 public:
 	NonNegativeInteger();
 	virtual ~NonNegativeInteger();
+	NonNegativeInteger(const NonNegativeInteger& other);
+	NonNegativeInteger& operator=(const NonNegativeInteger& other);
+#ifdef Q_COMPILER_RVALUE_REFS
+	NonNegativeInteger(NonNegativeInteger&& other);
+	NonNegativeInteger& operator=(NonNegativeInteger&& other);
+#endif
 };
 
 }
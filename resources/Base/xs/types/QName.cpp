@@ -5,6 +5,8 @@
  *      Author: alavier
  */
 
+#include <utility>
+
 #include "QName.h"
 
 namespace XS {
@@ -20,4 +22,30 @@ QName::~QName()
 
 }
 
+QName::QName(const QName& other)
+	: String(other)
+{
+
+}
+
+QName& QName::operator=(const QName& other)
+{
+	String::operator=(other);
+	return *this;
+}
+
+#ifdef Q_COMPILER_RVALUE_REFS
+QName::QName(QName&& other)
+	: String(std::move(other))
+{
+
+}
+
+QName& QName::operator=(QName&& other)
+{
+	String::operator=(std::move(other));
+	return *this;
+}
+#endif
+
 }
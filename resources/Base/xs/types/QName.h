@@ -16,6 +16,12 @@ class QName : public String {
 public:
 	QName();
 	virtual ~QName();
+	QName(const QName& other);
+	QName& operator=(const QName& other);
+#ifdef Q_COMPILER_RVALUE_REFS
+	QName(QName&& other);
+	QName& operator=(QName&& other);
+#endif
 };
 
 }
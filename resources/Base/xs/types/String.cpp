@@ -5,6 +5,10 @@
  *      Author: lgruber
  */
 
+#include <utility>
+
+#include "XmlEscape.h"
+
 #include "String.h"
 
 namespace XS {
@@ -19,11 +23,44 @@ String::~String()
 
 }
 
+String::String(const String& other)
+	: m_szValue(other.m_szValue)
+{
+
+}
+
+String& String::operator=(const String& other)
+{
+	m_szValue = other.m_szValue;
+	return *this;
+}
+
+#ifdef Q_COMPILER_RVALUE_REFS
+String::String(String&& other)
+	: m_szValue(std::move(other.m_szValue))
+{
+
+}
+
+String& String::operator=(String&& other)
+{
+	m_szValue = std::move(other.m_szValue);
+	return *this;
+}
+#endif
+
 void String::setValue(const QString& szValue)
 {
 	m_szValue = szValue;
 }
 
+#ifdef Q_COMPILER_RVALUE_REFS
+void String::setValue(QString&& szValue)
+{
+	m_szValue = std::move(szValue);
+}
+#endif
+
 const QString& String::getValue() const
 {
 	return m_szValue;
@@ -31,7 +68,7 @@ const QString& String::getValue() const
 
 QString String::serialize() const
 {
-	return m_szValue;
+	return XmlEscape::escape(m_szValue);
 }
 
 void String::deserialize(const QDomElement& element)
@@ -44,6 +81,17 @@ void String::deserialize(const QDomAttr& attr)
 	setValue(attr.value().trimmed());
 }
 
+void String::deserialize(QXmlStreamReader& reader)
+{
+	QString szText = reader.readElementText();
+	setValue(szText.trimmed());
+}
+
+void String::deserialize(const QXmlStreamAttribute& attr)
+{
+	setValue(attr.value().toString().trimmed());
+}
+
 bool String::isNull() const
 {
 	return m_szValue.isNull();
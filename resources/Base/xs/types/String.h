@@ -9,6 +9,7 @@
 #define XS_STRING_H_
 
 #include <QDomElement>
+#include <QXmlStreamReader>
 #include <QString>
 
 namespace XS {
@@ -18,13 +19,24 @@ class String
 public:
 	String();
 	virtual ~String();
+	String(const String& other);
+	String& operator=(const String& other);
+#ifdef Q_COMPILER_RVALUE_REFS
+	String(String&& other);
+	String& operator=(String&& other);
+#endif
 
 	void setValue(const QString& szValue);
+#ifdef Q_COMPILER_RVALUE_REFS
+	void setValue(QString&& szValue);
+#endif
 	const QString& getValue() const;
 
 	QString serialize() const;
 	void deserialize(const QDomElement& element);
 	void deserialize(const QDomAttr& attr);
+	void deserialize(QXmlStreamReader& reader);
+	void deserialize(const QXmlStreamAttribute& attr);
 
 	bool isNull() const;
 
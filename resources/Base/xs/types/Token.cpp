@@ -5,6 +5,8 @@
  *      Author: alavier
  */
 
+#include <utility>
+
 #include "Token.h"
 
 namespace XS {
@@ -20,4 +22,30 @@ Token::~Token()
 
 }
 
+Token::Token(const Token& other)
+	: String(other)
+{
+
+}
+
+Token& Token::operator=(const Token& other)
+{
+	String::operator=(other);
+	return *this;
+}
+
+#ifdef Q_COMPILER_RVALUE_REFS
+Token::Token(Token&& other)
+	: String(std::move(other))
+{
+
+}
+
+Token& Token::operator=(Token&& other)
+{
+	String::operator=(std::move(other));
+	return *this;
+}
+#endif
+
 }
@@ -16,6 +16,12 @@ class Token : public String {
 public:
 	Token();
 	virtual ~Token();
+	Token(const Token& other);
+	Token& operator=(const Token& other);
+#ifdef Q_COMPILER_RVALUE_REFS
+	Token(Token&& other);
+	Token& operator=(Token&& other);
+#endif
 };
 
 }
@@ -46,6 +46,17 @@ void UnsignedInteger::deserialize(const QDomAttr& attr)
 	setValue(attr.value().trimmed().toUInt());
 }
 
+void UnsignedInteger::deserialize(QXmlStreamReader& reader)
+{
+	QString szText = reader.readElementText();
+	setValue(szText.trimmed().toUInt());
+}
+
+void UnsignedInteger::deserialize(const QXmlStreamAttribute& attr)
+{
+	setValue(attr.value().toString().trimmed().toUInt());
+}
+
 bool UnsignedInteger::isNull() const
 {
 	return m_bIsNull;
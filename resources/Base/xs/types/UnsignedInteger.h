@@ -9,6 +9,7 @@
 #define XS_UNSIGNEDINTEGER_H_
 
 #include <QDomElement>
+#include <QXmlStreamReader>
 #include <QString>
 
 namespace XS {
@@ -25,6 +26,8 @@ public:
 	QString serialize() const;
 	void deserialize(const QDomElement& element);
 	void deserialize(const QDomAttr& attr);
+	void deserialize(QXmlStreamReader& reader);
+	void deserialize(const QXmlStreamAttribute& attr);
 
 	bool isNull() const;
 
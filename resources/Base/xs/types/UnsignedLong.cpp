@@ -46,6 +46,17 @@ void UnsignedLong::deserialize(const QDomAttr& attr)
 	setValue(attr.value().trimmed().toULong());
 }
 
+void UnsignedLong::deserialize(QXmlStreamReader& reader)
+{
+	QString szText = reader.readElementText();
+	setValue(szText.trimmed().toUInt());
+}
+
+void UnsignedLong::deserialize(const QXmlStreamAttribute& attr)
+{
+	setValue(attr.value().toString().trimmed().toULong());
+}
+
 bool UnsignedLong::isNull() const
 {
 	return m_bIsNull;
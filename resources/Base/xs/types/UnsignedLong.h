@@ -9,6 +9,7 @@
 #define XS_UNSIGNEDLONG_H_
 
 #include <QDomElement>
+#include <QXmlStreamReader>
 
 namespace XS {
 
@@ -23,6 +24,8 @@ public:
 	QString serialize() const;
 	void deserialize(const QDomElement& element);
 	void deserialize(const QDomAttr& attr);
+	void deserialize(QXmlStreamReader& reader);
+	void deserialize(const QXmlStreamAttribute& attr);
 
 	bool isNull() const;
 
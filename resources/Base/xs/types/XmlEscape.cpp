@@ -0,0 +1,127 @@
+/*
+ * XmlEscape.cpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define XS_XMLESCAPE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "XmlEscape.h"
+
+namespace XS {
+
+static inline bool isSpecialCharacter(ushort c)
+{
+	if(c < 0x20) {
+		return (c != '\t') && (c != '\n');
+	}
+	return (c == '<') || (c == '>') || (c == '&') || (c == '"') || (c == '\'');
+}
+
+QString XmlEscape::escape(const QString& szValue)
+{
+	const ushort* pData = reinterpret_cast<const ushort*>(szValue.constData());
+	int iSize = szValue.size();
+
+	int iPos = findNextSpecial(pData, 0, iSize);
+	if(iPos == iSize) {
+		return szValue;
+	}
+
+	QString szRet;
+	szRet.reserve(iSize + iSize / 8 + 8);
+
+	int iStart = 0;
+	while(iPos < iSize) {
+		szRet.append(szValue.constData() + iStart, iPos - iStart);
+		appendEntity(szRet, pData[iPos]);
+		iStart = iPos + 1;
+		iPos = findNextSpecial(pData, iStart, iSize);
+	}
+	szRet.append(szValue.constData() + iStart, iSize - iStart);
+
+	return szRet;
+}
+
+int XmlEscape::findNextSpecial(const ushort* pData, int iFrom, int iSize)
+{
+	int i = iFrom;
+
+#ifdef XS_XMLESCAPE_SSE2
+	const __m128i lt = _mm_set1_epi16('<');
+	const __m128i gt = _mm_set1_epi16('>');
+	const __m128i amp = _mm_set1_epi16('&');
+	const __m128i quot = _mm_set1_epi16('"');
+	const __m128i apos = _mm_set1_epi16('\'');
+	const __m128i tab = _mm_set1_epi16('\t');
+	const __m128i lf = _mm_set1_epi16('\n');
+	const __m128i ctrlMax = _mm_set1_epi16(0x1F);
+	const __m128i zero = _mm_setzero_si128();
+
+	for(; i + 8 <= iSize; i += 8) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+
+		__m128i mask = _mm_or_si128(_mm_cmpeq_epi16(chunk, lt), _mm_cmpeq_epi16(chunk, gt));
+		mask = _mm_or_si128(mask, _mm_cmpeq_epi16(chunk, amp));
+		mask = _mm_or_si128(mask, _mm_cmpeq_epi16(chunk, quot));
+		mask = _mm_or_si128(mask, _mm_cmpeq_epi16(chunk, apos));
+
+		// Unsigned saturated subtraction gives zero for the control characters only
+		__m128i ctrl = _mm_cmpeq_epi16(_mm_subs_epu16(chunk, ctrlMax), zero);
+		ctrl = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi16(chunk, tab), _mm_cmpeq_epi16(chunk, lf)), ctrl);
+		mask = _mm_or_si128(mask, ctrl);
+
+		int iMask = _mm_movemask_epi8(mask);
+		if(iMask != 0) {
+			// Two bits per code unit
+			int iOffset = 0;
+			while(!(iMask & 1)) {
+				iMask >>= 2;
+				iOffset++;
+			}
+			return i + iOffset;
+		}
+	}
+#endif
+
+	for(; i < iSize; ++i) {
+		if(isSpecialCharacter(pData[i])) {
+			return i;
+		}
+	}
+	return iSize;
+}
+
+void XmlEscape::appendEntity(QString& szRet, ushort c)
+{
+	switch(c) {
+	case '<':
+		szRet += QLatin1String("&lt;");
+		break;
+	case '>':
+		szRet += QLatin1String("&gt;");
+		break;
+	case '&':
+		szRet += QLatin1String("&amp;");
+		break;
+	case '"':
+		szRet += QLatin1String("&quot;");
+		break;
+	case '\'':
+		szRet += QLatin1String("&apos;");
+		break;
+	case '\r':
+		// Kept as a reference so the parser does not normalize it to a line feed
+		szRet += QLatin1String("&#13;");
+		break;
+	default:
+		// Other C0 controls cannot be represented in XML 1.0, even as references
+		szRet += QChar(QChar::ReplacementCharacter);
+		break;
+	}
+}
+
+}
@@ -0,0 +1,36 @@
+/*
+ * XmlEscape.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef XS_XMLESCAPE_H_
+#define XS_XMLESCAPE_H_
+
+#include <QString>
+
+namespace XS {
+
+/*
+ * Escaping of the character data written in the messages. The value is scanned
+ * eight UTF-16 code units at a time with SSE2 when it is available, runs without
+ * special characters are copied as a block, and a value that needs no escaping
+ * is returned as is without any copy.
+ *
+ * Carriage returns are written as &#13;, the other control characters, except
+ * tab and line feed, are not allowed in XML 1.0 and are replaced by U+FFFD.
+ *
+ * There is no unescaping counterpart: the XML readers already resolve entities.
+ */
+class XmlEscape
+{
+public:
+	static QString escape(const QString& szValue);
+
+private:
+	static int findNextSpecial(const ushort* pData, int iFrom, int iSize);
+	static void appendEntity(QString& szRet, ushort c);
+};
+
+}
+#endif /* XS_XMLESCAPE_H_ */
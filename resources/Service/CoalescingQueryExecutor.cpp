@@ -0,0 +1,220 @@
+/*
+ * CoalescingQueryExecutor.cpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#include <QMutexLocker>
+#include <QThread>
+
+#include "CoalescingQueryExecutor.h"
+#include "ResponseCache.h"
+#include "ResponseInflater.h"
+
+namespace SOAPERO {
+
+struct CoalescingQueryExecutor::Flight
+{
+	Flight()
+	{
+		owner = QThread::currentThreadId();
+		bFinished = false;
+	}
+
+	Qt::HANDLE owner;
+	bool bFinished;
+	IQueryExecutorResponse response;
+};
+
+// Asynchronous query of a thread with the callbacks of the identical queries
+class CoalescingQueryExecutor::AsyncFlight : public IQueryCallback
+{
+public:
+	AsyncFlight(AsyncFlightHash* pFlights, const QByteArray& key, IQueryCallback* pCallback)
+		: m_key(key)
+	{
+		m_pFlights = pFlights;
+		m_listCallbacks.append(pCallback);
+	}
+
+	void addCallback(IQueryCallback* pCallback)
+	{
+		m_listCallbacks.append(pCallback);
+	}
+
+	virtual void queryFinished(const IQueryExecutorResponse& response)
+	{
+		// The callbacks may send the same query again, it starts a new flight
+		m_pFlights->remove(m_key);
+		QList<IQueryCallback*> listCallbacks = m_listCallbacks;
+		delete this;
+
+		QList<IQueryCallback*>::const_iterator iter;
+		for(iter = listCallbacks.constBegin(); iter != listCallbacks.constEnd(); ++iter) {
+			(*iter)->queryFinished(response);
+		}
+	}
+
+private:
+	AsyncFlightHash* m_pFlights;
+	QByteArray m_key;
+	QList<IQueryCallback*> m_listCallbacks;
+};
+
+CoalescingQueryExecutor::CoalescingQueryExecutor(IQueryExecutor* pExecutor)
+{
+	m_pExecutor = pExecutor;
+	m_statistics.iQueryCount = 0;
+	m_statistics.iCoalescedCount = 0;
+}
+
+CoalescingQueryExecutor::~CoalescingQueryExecutor()
+{
+	if(m_pExecutor) {
+		delete m_pExecutor;
+		m_pExecutor = NULL;
+	}
+}
+
+CoalescingQueryExecutor::Statistics CoalescingQueryExecutor::getStatistics() const
+{
+	QMutexLocker locker(&m_mutex);
+	return m_statistics;
+}
+
+QByteArray CoalescingQueryExecutor::buildKey(const QNetworkRequest& request, const QByteArray& bytes)
+{
+	// A compressed body would hide the SOAP header, and its nonce, from ResponseCache::buildKey()
+	QByteArray body = bytes;
+	ResponseInflater::inflateAll(request.rawHeader("Content-Encoding"), body);
+	return ResponseCache::buildKey(request.url(), request.rawHeader("SoapAction").constData(), body);
+}
+
+bool CoalescingQueryExecutor::joinFlight(const QByteArray& key, QSharedPointer<Flight>& pFlight, IQueryExecutorResponse& response)
+{
+	QMutexLocker locker(&m_mutex);
+	m_statistics.iQueryCount++;
+
+	pFlight = m_hashFlights.value(key);
+	if(!pFlight) {
+		pFlight = QSharedPointer<Flight>(new Flight());
+		m_hashFlights.insert(key, pFlight);
+		return false;
+	}
+
+	// Waiting for a flight of the same thread would never end, the query is sent separately
+	if(pFlight->owner == QThread::currentThreadId()) {
+		pFlight.clear();
+		return false;
+	}
+
+	m_statistics.iCoalescedCount++;
+	while(!pFlight->bFinished) {
+		m_flightFinished.wait(&m_mutex);
+	}
+	response = pFlight->response;
+	pFlight.clear();
+	return true;
+}
+
+void CoalescingQueryExecutor::finishFlight(const QByteArray& key, const QSharedPointer<Flight>& pFlight, const IQueryExecutorResponse& response)
+{
+	QMutexLocker locker(&m_mutex);
+	pFlight->response = response;
+	pFlight->bFinished = true;
+	m_hashFlights.remove(key);
+	m_flightFinished.wakeAll();
+}
+
+void CoalescingQueryExecutor::addQueryCount(bool bCoalesced)
+{
+	QMutexLocker locker(&m_mutex);
+	m_statistics.iQueryCount++;
+	if(bCoalesced) {
+		m_statistics.iCoalescedCount++;
+	}
+}
+
+IQueryExecutorResponse CoalescingQueryExecutor::execQuery(const QNetworkRequest& request, const QByteArray& bytes)
+{
+	QByteArray key = buildKey(request, bytes);
+	QSharedPointer<Flight> pFlight;
+	IQueryExecutorResponse response;
+	if(joinFlight(key, pFlight, response)) {
+		return response;
+	}
+
+	response = m_pExecutor->execQuery(request, bytes);
+	if(pFlight) {
+		finishFlight(key, pFlight, response);
+	}
+	return response;
+}
+
+QIODevice* CoalescingQueryExecutor::openQuery(const QNetworkRequest& request, const QByteArray& bytes)
+{
+	QByteArray key = buildKey(request, bytes);
+	QSharedPointer<Flight> pFlight;
+	IQueryExecutorResponse response;
+	if(joinFlight(key, pFlight, response)) {
+		QIODevice* pBuffer = new QueryResponseBuffer(response);
+		QMutexLocker locker(&m_mutex);
+		m_setCoalescedDevices.insert(pBuffer);
+		return pBuffer;
+	}
+
+	QIODevice* pDevice = m_pExecutor->openQuery(request, bytes);
+	if(pFlight) {
+		// The response is given to the other queries once it is read by closeQuery()
+		QMutexLocker locker(&m_mutex);
+		m_hashFlightDevices.insert(pDevice, qMakePair(key, pFlight));
+	}
+	return pDevice;
+}
+
+void CoalescingQueryExecutor::closeQuery(QIODevice* pDevice, IQueryExecutorResponse& response)
+{
+	bool bCoalesced;
+	QPair<QByteArray, QSharedPointer<Flight> > flight;
+	{
+		QMutexLocker locker(&m_mutex);
+		bCoalesced = m_setCoalescedDevices.remove(pDevice);
+		if(!bCoalesced) {
+			flight = m_hashFlightDevices.take(pDevice);
+		}
+	}
+
+	if(bCoalesced) {
+		// Buffer released by the default implementation
+		IQueryExecutor::closeQuery(pDevice, response);
+		return;
+	}
+
+	m_pExecutor->closeQuery(pDevice, response);
+	if(flight.second) {
+		finishFlight(flight.first, flight.second, response);
+	}
+}
+
+void CoalescingQueryExecutor::postQuery(const QNetworkRequest& request, const QByteArray& bytes, IQueryCallback* pCallback)
+{
+	if(!m_asyncFlights.hasLocalData()) {
+		m_asyncFlights.setLocalData(new AsyncFlightHash());
+	}
+	AsyncFlightHash* pFlights = m_asyncFlights.localData();
+
+	QByteArray key = buildKey(request, bytes);
+	AsyncFlight* pFlight = pFlights->value(key);
+	if(pFlight) {
+		pFlight->addCallback(pCallback);
+		addQueryCount(true);
+		return;
+	}
+
+	addQueryCount(false);
+	pFlight = new AsyncFlight(pFlights, key, pCallback);
+	pFlights->insert(key, pFlight);
+	m_pExecutor->postQuery(request, bytes, pFlight);
+}
+
+}
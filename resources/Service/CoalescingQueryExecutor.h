@@ -0,0 +1,84 @@
+/*
+ * CoalescingQueryExecutor.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef COALESCINGQUERYEXECUTOR_H_
+#define COALESCINGQUERYEXECUTOR_H_
+
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QSharedPointer>
+#include <QThreadStorage>
+#include <QWaitCondition>
+
+#include "Service.h"
+
+namespace SOAPERO {
+
+/*
+ * Query executor sending only once the identical queries in flight at the same
+ * time, through another executor. A query is identical to a running one when
+ * it has the same URL, SOAP action and message body; the SOAP header is left
+ * out as it changes with each WS-Security nonce. Compressed bodies are decoded
+ * before being compared.
+ *
+ * A blocking query from another thread waits for the running one and gets a
+ * copy of its response, the content itself being shared. Asynchronous queries
+ * are coalesced with the other asynchronous queries of the same thread, each
+ * callback being called with the response. Each caller then parses its own
+ * response objects.
+ *
+ *   service.setQueryExecutor(new CoalescingQueryExecutor(new PooledQueryExecutor()));
+ */
+class CoalescingQueryExecutor : public IQueryExecutor
+{
+public:
+	struct Statistics
+	{
+		qint64 iQueryCount;
+		qint64 iCoalescedCount; // Queries given the response of another one
+	};
+
+	// The executor is owned
+	CoalescingQueryExecutor(IQueryExecutor* pExecutor);
+	virtual ~CoalescingQueryExecutor();
+
+	Statistics getStatistics() const;
+
+	virtual IQueryExecutorResponse execQuery(const QNetworkRequest& request, const QByteArray& bytes);
+	virtual QIODevice* openQuery(const QNetworkRequest& request, const QByteArray& bytes);
+	virtual void closeQuery(QIODevice* pDevice, IQueryExecutorResponse& response);
+	virtual void postQuery(const QNetworkRequest& request, const QByteArray& bytes, IQueryCallback* pCallback);
+
+private:
+	struct Flight;
+	class AsyncFlight;
+	typedef QHash<QByteArray, AsyncFlight*> AsyncFlightHash;
+
+	static QByteArray buildKey(const QNetworkRequest& request, const QByteArray& bytes);
+	// Return true with the response of an identical query of another thread. Otherwise
+	// the caller sends the query and leads a new flight if one is returned.
+	bool joinFlight(const QByteArray& key, QSharedPointer<Flight>& pFlight, IQueryExecutorResponse& response);
+	void finishFlight(const QByteArray& key, const QSharedPointer<Flight>& pFlight, const IQueryExecutorResponse& response);
+	void addQueryCount(bool bCoalesced);
+
+	IQueryExecutor* m_pExecutor;
+
+	mutable QMutex m_mutex;
+	QWaitCondition m_flightFinished;
+	QHash<QByteArray, QSharedPointer<Flight> > m_hashFlights;
+	// Devices opened for a flight by its leader
+	QHash<QIODevice*, QPair<QByteArray, QSharedPointer<Flight> > > m_hashFlightDevices;
+	// Devices of the queries given the response of another one
+	QSet<QIODevice*> m_setCoalescedDevices;
+	Statistics m_statistics;
+
+	QThreadStorage<AsyncFlightHash*> m_asyncFlights;
+};
+
+}
+
+#endif /* COALESCINGQUERYEXECUTOR_H_ */
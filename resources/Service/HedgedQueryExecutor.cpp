@@ -0,0 +1,320 @@
+/*
+ * HedgedQueryExecutor.cpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#include <algorithm>
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QMutexLocker>
+#include <QNetworkReply>
+#include <QTimer>
+#include <QTimerEvent>
+
+#include "HedgedQueryExecutor.h"
+
+#define HEDGE_LATENCY_COUNT 512
+#define HEDGE_MIN_LATENCY_COUNT 20
+#define HEDGE_UPDATE_INTERVAL 16
+
+namespace SOAPERO {
+
+// Hedged query of postQuery(), it deletes itself once the callback is called.
+// The replies are connected with pointers to member and the hedge delay uses
+// QObject::timerEvent() so no meta object is needed.
+class HedgedQueryExecutor::AsyncHedgedQuery : public QObject
+{
+public:
+	AsyncHedgedQuery(HedgedQueryExecutor* pExecutor, const QNetworkRequest& request, const QByteArray& bytes,
+			IQueryCallback* pCallback, int iHedgeDelay)
+		: m_request(request), m_bytes(bytes)
+	{
+		m_pExecutor = pExecutor;
+		m_pCallback = pCallback;
+		m_pHedge = NULL;
+		m_iHedgeStartTime = 0;
+		m_timer.start();
+
+		m_pPrimary = m_pExecutor->sendQuery(m_request, m_bytes);
+		QObject::connect(m_pPrimary, &QNetworkReply::finished, this, &AsyncHedgedQuery::onPrimaryFinished);
+		m_iTimerId = (iHedgeDelay >= 0 ? startTimer(iHedgeDelay) : 0);
+	}
+
+	// As in execQuery(), a failed query, HTTP error included, waits for the other one
+	// if it is still running
+	void onPrimaryFinished()
+	{
+		if(m_pPrimary->error() != QNetworkReply::NoError && m_pHedge && !m_pHedge->isFinished()) {
+			return;
+		}
+		finish(m_pPrimary, m_pHedge, m_timer.elapsed(), false);
+	}
+
+	void onHedgeFinished()
+	{
+		if(m_pHedge->error() != QNetworkReply::NoError && !m_pPrimary->isFinished()) {
+			return;
+		}
+		finish(m_pHedge, m_pPrimary, m_timer.elapsed() - m_iHedgeStartTime, true);
+	}
+
+protected:
+	virtual void timerEvent(QTimerEvent*)
+	{
+		killTimer(m_iTimerId);
+		m_iTimerId = 0;
+		if(!m_pPrimary->isFinished() && m_pExecutor->acquireHedge()) {
+			m_iHedgeStartTime = m_timer.elapsed();
+			m_pHedge = m_pExecutor->sendQuery(m_request, m_bytes);
+			QObject::connect(m_pHedge, &QNetworkReply::finished, this, &AsyncHedgedQuery::onHedgeFinished);
+		}
+	}
+
+private:
+	void finish(QNetworkReply* pWinner, QNetworkReply* pLoser, qint64 iLatency, bool bHedgeWin)
+	{
+		if(m_iTimerId) {
+			killTimer(m_iTimerId);
+		}
+		if(pLoser) {
+			QObject::disconnect(pLoser, 0, this, 0);
+			m_pExecutor->releaseQuery(pLoser);
+		}
+
+		IQueryExecutorResponse response = readResponse(pWinner);
+		m_pExecutor->releaseQuery(pWinner);
+		m_pExecutor->finishHedgeableQuery(iLatency, bHedgeWin);
+
+		IQueryCallback* pCallback = m_pCallback;
+		delete this;
+		pCallback->queryFinished(response);
+	}
+
+	HedgedQueryExecutor* m_pExecutor;
+	QNetworkRequest m_request;
+	QByteArray m_bytes;
+	IQueryCallback* m_pCallback;
+
+	QNetworkReply* m_pPrimary;
+	QNetworkReply* m_pHedge;
+	int m_iTimerId;
+	QElapsedTimer m_timer;
+	qint64 m_iHedgeStartTime;
+};
+
+HedgedQueryExecutor::HedgedQueryExecutor()
+{
+	m_iPercentile = 95;
+	m_iMinHedgeDelay = 10;
+	m_iBudgetPercent = 5;
+	m_iNextLatency = 0;
+	m_iLatenciesSinceUpdate = 0;
+	m_statistics.iQueryCount = 0;
+	m_statistics.iHedgeCount = 0;
+	m_statistics.iHedgeWinCount = 0;
+	m_statistics.iHedgeDelay = -1;
+}
+
+HedgedQueryExecutor::~HedgedQueryExecutor()
+{
+
+}
+
+void HedgedQueryExecutor::setIdempotentSoapActions(const QSet<QByteArray>& setSoapActions)
+{
+	QMutexLocker locker(&m_mutex);
+	m_setIdempotentSoapActions = setSoapActions;
+}
+
+void HedgedQueryExecutor::setHedgePercentile(int iPercentile)
+{
+	QMutexLocker locker(&m_mutex);
+	m_iPercentile = qBound(1, iPercentile, 100);
+	m_iLatenciesSinceUpdate = HEDGE_UPDATE_INTERVAL;
+}
+
+int HedgedQueryExecutor::getHedgePercentile() const
+{
+	QMutexLocker locker(&m_mutex);
+	return m_iPercentile;
+}
+
+void HedgedQueryExecutor::setMinHedgeDelay(int iMinHedgeDelay)
+{
+	QMutexLocker locker(&m_mutex);
+	m_iMinHedgeDelay = qMax(0, iMinHedgeDelay);
+	m_iLatenciesSinceUpdate = HEDGE_UPDATE_INTERVAL;
+}
+
+int HedgedQueryExecutor::getMinHedgeDelay() const
+{
+	QMutexLocker locker(&m_mutex);
+	return m_iMinHedgeDelay;
+}
+
+void HedgedQueryExecutor::setHedgeBudget(int iBudgetPercent)
+{
+	QMutexLocker locker(&m_mutex);
+	m_iBudgetPercent = qBound(0, iBudgetPercent, 100);
+}
+
+int HedgedQueryExecutor::getHedgeBudget() const
+{
+	QMutexLocker locker(&m_mutex);
+	return m_iBudgetPercent;
+}
+
+HedgedQueryExecutor::Statistics HedgedQueryExecutor::getHedgeStatistics() const
+{
+	QMutexLocker locker(&m_mutex);
+	return m_statistics;
+}
+
+bool HedgedQueryExecutor::isIdempotent(const QNetworkRequest& request) const
+{
+	QMutexLocker locker(&m_mutex);
+	return m_setIdempotentSoapActions.isEmpty() || m_setIdempotentSoapActions.contains(request.rawHeader("SoapAction"));
+}
+
+int HedgedQueryExecutor::startHedgeableQuery()
+{
+	QMutexLocker locker(&m_mutex);
+	m_statistics.iQueryCount++;
+
+	if(m_vectorLatencies.size() < HEDGE_MIN_LATENCY_COUNT) {
+		return -1;
+	}
+
+	// The percentile is computed again after a few new latencies only
+	if(m_statistics.iHedgeDelay < 0 || m_iLatenciesSinceUpdate >= HEDGE_UPDATE_INTERVAL) {
+		QVector<qint64> vectorLatencies = m_vectorLatencies;
+		int iCount = (int)vectorLatencies.size();
+		int iIndex = qMin(iCount - 1, (iCount * m_iPercentile) / 100);
+		std::nth_element(vectorLatencies.begin(), vectorLatencies.begin() + iIndex, vectorLatencies.end());
+		m_statistics.iHedgeDelay = (int)qMax((qint64)m_iMinHedgeDelay, vectorLatencies.at(iIndex));
+		m_iLatenciesSinceUpdate = 0;
+	}
+	return m_statistics.iHedgeDelay;
+}
+
+bool HedgedQueryExecutor::acquireHedge()
+{
+	QMutexLocker locker(&m_mutex);
+	if((m_statistics.iHedgeCount + 1) * 100 > m_statistics.iQueryCount * m_iBudgetPercent) {
+		return false;
+	}
+	m_statistics.iHedgeCount++;
+	return true;
+}
+
+void HedgedQueryExecutor::finishHedgeableQuery(qint64 iLatency, bool bHedgeWin)
+{
+	QMutexLocker locker(&m_mutex);
+	if(m_vectorLatencies.size() < HEDGE_LATENCY_COUNT) {
+		m_vectorLatencies.append(iLatency);
+	}else{
+		m_vectorLatencies[m_iNextLatency] = iLatency;
+		m_iNextLatency = (m_iNextLatency + 1) % HEDGE_LATENCY_COUNT;
+	}
+	m_iLatenciesSinceUpdate++;
+	if(bHedgeWin) {
+		m_statistics.iHedgeWinCount++;
+	}
+}
+
+IQueryExecutorResponse HedgedQueryExecutor::execQuery(const QNetworkRequest& request, const QByteArray& bytes)
+{
+	if(!isIdempotent(request)) {
+		return PooledQueryExecutor::execQuery(request, bytes);
+	}
+
+	int iHedgeDelay = startHedgeableQuery();
+	QElapsedTimer timer;
+	timer.start();
+
+	QEventLoop loop;
+	QTimer hedgeTimer;
+	hedgeTimer.setSingleShot(true);
+	QObject::connect(&hedgeTimer, SIGNAL(timeout()), &loop, SLOT(quit()));
+
+	QNetworkReply* pPrimary = sendQuery(request, bytes);
+	QObject::connect(pPrimary, SIGNAL(finished()), &loop, SLOT(quit()));
+	if(!pPrimary->isFinished() && iHedgeDelay >= 0) {
+		hedgeTimer.start(iHedgeDelay);
+		loop.exec();
+	}
+
+	QNetworkReply* pHedge = NULL;
+	qint64 iHedgeStartTime = 0;
+	if(!pPrimary->isFinished() && iHedgeDelay >= 0 && acquireHedge()) {
+		iHedgeStartTime = timer.elapsed();
+		pHedge = sendQuery(request, bytes);
+		QObject::connect(pHedge, SIGNAL(finished()), &loop, SLOT(quit()));
+	}
+
+	// Wait for the first successful response, a failed query waits for the other one
+	QNetworkReply* pWinner = NULL;
+	while(!pWinner) {
+		if(pHedge && pHedge->isFinished() && (pHedge->error() == QNetworkReply::NoError || pPrimary->isFinished())) {
+			pWinner = pHedge;
+		}else if(pPrimary->isFinished() && (pPrimary->error() == QNetworkReply::NoError || !pHedge || pHedge->isFinished())) {
+			pWinner = pPrimary;
+		}else{
+			loop.exec();
+		}
+	}
+
+	QNetworkReply* pLoser = (pWinner == pPrimary ? pHedge : pPrimary);
+	if(pLoser) {
+		QObject::disconnect(pLoser, 0, &loop, 0);
+		releaseQuery(pLoser);
+	}
+
+	IQueryExecutorResponse response = readResponse(pWinner);
+	releaseQuery(pWinner);
+	finishHedgeableQuery(timer.elapsed() - (pWinner == pHedge ? iHedgeStartTime : 0), pWinner == pHedge);
+
+	return response;
+}
+
+QIODevice* HedgedQueryExecutor::openQuery(const QNetworkRequest& request, const QByteArray& bytes)
+{
+	if(!isIdempotent(request)) {
+		return PooledQueryExecutor::openQuery(request, bytes);
+	}
+
+	// The hedged responses are read entirely by execQuery()
+	QIODevice* pDevice = IQueryExecutor::openQuery(request, bytes);
+	QMutexLocker locker(&m_mutex);
+	m_setHedgedDevices.insert(pDevice);
+	return pDevice;
+}
+
+void HedgedQueryExecutor::closeQuery(QIODevice* pDevice, IQueryExecutorResponse& response)
+{
+	bool bHedged;
+	{
+		QMutexLocker locker(&m_mutex);
+		bHedged = m_setHedgedDevices.remove(pDevice);
+	}
+
+	if(bHedged) {
+		IQueryExecutor::closeQuery(pDevice, response);
+	}else{
+		PooledQueryExecutor::closeQuery(pDevice, response);
+	}
+}
+
+void HedgedQueryExecutor::postQuery(const QNetworkRequest& request, const QByteArray& bytes, IQueryCallback* pCallback)
+{
+	if(!isIdempotent(request)) {
+		PooledQueryExecutor::postQuery(request, bytes, pCallback);
+		return;
+	}
+
+	new AsyncHedgedQuery(this, request, bytes, pCallback, startHedgeableQuery());
+}
+
+}
@@ -0,0 +1,98 @@
+/*
+ * HedgedQueryExecutor.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef HEDGEDQUERYEXECUTOR_H_
+#define HEDGEDQUERYEXECUTOR_H_
+
+#include <QMutex>
+#include <QSet>
+#include <QVector>
+
+#include "PooledQueryExecutor.h"
+
+namespace SOAPERO {
+
+/*
+ * Pooled executor cutting the tail latency of the idempotent queries: when the
+ * response of a query is not received after the hedge delay, the same query is
+ * sent again and the first response received is used, the other query being
+ * aborted.
+ *
+ * The delay follows a percentile (95th by default) of the latencies observed
+ * for the last queries; no query is hedged until enough latencies are known.
+ * The budget caps the hedged queries to a percentage of the queries.
+ *
+ * The hedged queries are read entirely before being parsed and do not wait
+ * for the connections per host limit. The other ones are sent as by
+ * PooledQueryExecutor.
+ *
+ * The hedge sends the same bytes again, WS-Security nonce and creation time
+ * included: do not hedge the queries of a service using
+ * setUseWSUsernameToken(true) with a server rejecting replayed nonces.
+ */
+class HedgedQueryExecutor : public PooledQueryExecutor
+{
+public:
+	struct Statistics
+	{
+		qint64 iQueryCount; // Queries which could be hedged
+		qint64 iHedgeCount;
+		qint64 iHedgeWinCount; // Hedged queries answered first
+		int iHedgeDelay; // In milliseconds, -1 until enough latencies are known
+	};
+
+	HedgedQueryExecutor();
+	virtual ~HedgedQueryExecutor();
+
+	// SOAP actions of the idempotent operations, the only ones to be hedged. With an empty
+	// set (default) every query is hedged, for services with read-only operations only.
+	void setIdempotentSoapActions(const QSet<QByteArray>& setSoapActions);
+	// Percentile of the latencies used as hedge delay
+	void setHedgePercentile(int iPercentile);
+	int getHedgePercentile() const;
+	// Lower bound of the hedge delay in milliseconds
+	void setMinHedgeDelay(int iMinHedgeDelay);
+	int getMinHedgeDelay() const;
+	// Maximum percentage of hedged queries
+	void setHedgeBudget(int iBudgetPercent);
+	int getHedgeBudget() const;
+
+	Statistics getHedgeStatistics() const;
+
+	virtual IQueryExecutorResponse execQuery(const QNetworkRequest& request, const QByteArray& bytes);
+	virtual QIODevice* openQuery(const QNetworkRequest& request, const QByteArray& bytes);
+	virtual void closeQuery(QIODevice* pDevice, IQueryExecutorResponse& response);
+	virtual void postQuery(const QNetworkRequest& request, const QByteArray& bytes, IQueryCallback* pCallback);
+
+private:
+	class AsyncHedgedQuery;
+
+	bool isIdempotent(const QNetworkRequest& request) const;
+	// Count a query and give its hedge delay, -1 to not hedge it
+	int startHedgeableQuery();
+	// Take a hedge from the budget
+	bool acquireHedge();
+	void finishHedgeableQuery(qint64 iLatency, bool bHedgeWin);
+
+	mutable QMutex m_mutex;
+	QSet<QByteArray> m_setIdempotentSoapActions;
+	int m_iPercentile;
+	int m_iMinHedgeDelay;
+	int m_iBudgetPercent;
+
+	// Last latencies, in a ring
+	QVector<qint64> m_vectorLatencies;
+	int m_iNextLatency;
+	int m_iLatenciesSinceUpdate;
+	Statistics m_statistics;
+
+	// Devices of the hedged queries given by openQuery()
+	QSet<QIODevice*> m_setHedgedDevices;
+};
+
+}
+
+#endif /* HEDGEDQUERYEXECUTOR_H_ */
@@ -0,0 +1,34 @@
+/*
+ * NameHash.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef NAMEHASH_H_
+#define NAMEHASH_H_
+
+#include <QtGlobal>
+
+namespace SOAPERO {
+
+/*
+ * Hash of an XML local name used by the generated deserializers to dispatch
+ * child elements with a switch. The generator computes the case labels with the
+ * same FNV-1a function on the UTF-16 code units, so both sides must stay in sync.
+ *
+ * Templated to accept QString, QStringRef (Qt 5) and QStringView (Qt 6).
+ */
+template<class S>
+inline quint32 nameHash(const S& szName)
+{
+	quint32 iHash = 2166136261U;
+	for(int i = 0; i < (int)szName.size(); ++i) {
+		iHash ^= szName.at(i).unicode();
+		iHash *= 16777619U;
+	}
+	return iHash;
+}
+
+}
+
+#endif /* NAMEHASH_H_ */
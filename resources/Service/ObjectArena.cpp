@@ -0,0 +1,197 @@
+/*
+ * ObjectArena.cpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#include <new>
+
+#include <QAtomicInt>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include "ObjectArena.h"
+
+#ifdef _MSC_VER
+#define SOAPERO_THREAD_LOCAL __declspec(thread)
+#else
+#define SOAPERO_THREAD_LOCAL __thread
+#endif
+
+namespace SOAPERO {
+
+// Placed before each arena object, padded to keep the object aligned on 16 bytes
+struct ObjectArena::Header
+{
+	struct Info
+	{
+		DestroyFunc destroy; // NULL once the object has been deleted
+		Header* pNext;
+	};
+
+	union {
+		Info info;
+		char padding[32];
+	};
+};
+
+static SOAPERO_THREAD_LOCAL ObjectArena* g_pCurrentArena = NULL;
+
+// Blocks of all the arenas by start address with their end, for release() to tell the
+// arena objects from the heap ones. The count keeps the registry out of the heap path
+// as long as no arena holds a block.
+static QMutex g_blocksMutex;
+static QMap<quintptr, quintptr> g_mapBlocks;
+static QAtomicInt g_iBlockCount;
+
+static bool isInBlock(const void* pObject)
+{
+	if(g_iBlockCount.loadAcquire() == 0) {
+		return false;
+	}
+
+	quintptr iAddress = (quintptr)pObject;
+	QMutexLocker locker(&g_blocksMutex);
+	QMap<quintptr, quintptr>::const_iterator iter = g_mapBlocks.upperBound(iAddress);
+	if(iter == g_mapBlocks.constBegin()) {
+		return false;
+	}
+	--iter;
+	return (iAddress < iter.value());
+}
+
+static inline size_t alignSize(size_t iSize)
+{
+	return (iSize + 15) & ~((size_t)15);
+}
+
+ObjectArena::ObjectArena(int iBlockSize)
+{
+	m_iBlockSize = iBlockSize;
+	m_pCurrent = NULL;
+	m_pEnd = NULL;
+	m_pFirstHeader = NULL;
+	m_pLastHeader = NULL;
+}
+
+ObjectArena::~ObjectArena()
+{
+	clear();
+}
+
+void ObjectArena::clear()
+{
+	// Destroy in order of allocation: owners are allocated before their members
+	// and delete them, which marks them as already destroyed
+	Header* pHeader = m_pFirstHeader;
+	while(pHeader) {
+		if(pHeader->info.destroy) {
+			DestroyFunc destroy = pHeader->info.destroy;
+			pHeader->info.destroy = NULL;
+			destroy(pHeader + 1);
+		}
+		pHeader = pHeader->info.pNext;
+	}
+	m_pFirstHeader = NULL;
+	m_pLastHeader = NULL;
+
+	if(!m_listBlocks.isEmpty()) {
+		QMutexLocker locker(&g_blocksMutex);
+		QList<char*>::const_iterator iter;
+		for(iter = m_listBlocks.constBegin(); iter != m_listBlocks.constEnd(); ++iter) {
+			g_mapBlocks.remove((quintptr)*iter);
+			::operator delete(*iter);
+		}
+		g_iBlockCount.fetchAndAddOrdered(-(int)m_listBlocks.size());
+	}
+	m_listBlocks.clear();
+	m_pCurrent = NULL;
+	m_pEnd = NULL;
+}
+
+void* ObjectArena::allocate(size_t iSize, DestroyFunc destroy)
+{
+	ObjectArena* pArena = g_pCurrentArena;
+	if(!pArena) {
+		return ::operator new(iSize);
+	}
+
+	Header* pHeader = static_cast<Header*>(pArena->allocateInBlock(sizeof(Header) + alignSize(iSize)));
+	if(pArena->m_pLastHeader) {
+		pArena->m_pLastHeader->info.pNext = pHeader;
+	}else{
+		pArena->m_pFirstHeader = pHeader;
+	}
+	pArena->m_pLastHeader = pHeader;
+	pHeader->info.pNext = NULL;
+	pHeader->info.destroy = destroy;
+
+	return pHeader + 1;
+}
+
+void ObjectArena::release(void* pObject)
+{
+	if(!pObject) {
+		return;
+	}
+
+	if(isInBlock(pObject)) {
+		// The destructor already ran, the memory is released with the arena
+		Header* pHeader = static_cast<Header*>(pObject) - 1;
+		pHeader->info.destroy = NULL;
+	}else{
+		::operator delete(pObject);
+	}
+}
+
+bool ObjectArena::isActive()
+{
+	return (g_pCurrentArena != NULL);
+}
+
+void* ObjectArena::allocateInBlock(size_t iSize)
+{
+	if(m_pCurrent == NULL || (size_t)(m_pEnd - m_pCurrent) < iSize) {
+		size_t iBlockSize = ((size_t)m_iBlockSize < iSize ? iSize : (size_t)m_iBlockSize);
+		char* pBlock = static_cast<char*>(::operator new(iBlockSize));
+		m_listBlocks.append(pBlock);
+		{
+			QMutexLocker locker(&g_blocksMutex);
+			g_mapBlocks.insert((quintptr)pBlock, (quintptr)(pBlock + iBlockSize));
+		}
+		g_iBlockCount.fetchAndAddOrdered(1);
+		m_pCurrent = pBlock;
+		m_pEnd = pBlock + iBlockSize;
+	}
+
+	void* pData = m_pCurrent;
+	m_pCurrent += iSize;
+	return pData;
+}
+
+ObjectArena::Scope::Scope(ObjectArena* pArena)
+{
+	m_pPreviousArena = g_pCurrentArena;
+	if(pArena) {
+		g_pCurrentArena = pArena;
+	}
+}
+
+ObjectArena::Scope::~Scope()
+{
+	g_pCurrentArena = m_pPreviousArena;
+}
+
+ObjectArena::HeapScope::HeapScope()
+{
+	m_pPreviousArena = g_pCurrentArena;
+	g_pCurrentArena = NULL;
+}
+
+ObjectArena::HeapScope::~HeapScope()
+{
+	g_pCurrentArena = m_pPreviousArena;
+}
+
+}
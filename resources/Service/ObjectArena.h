@@ -0,0 +1,97 @@
+/*
+ * ObjectArena.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef OBJECTARENA_H_
+#define OBJECTARENA_H_
+
+#include <stddef.h>
+
+#include <QList>
+
+namespace SOAPERO {
+
+/*
+ * Region allocator for the object graph of a response. The generated classes
+ * route their operator new/delete through ObjectArena::allocate()/release():
+ * while an arena is active on the current thread (see ObjectArena::Scope) the
+ * generated objects are carved out of large blocks instead of being allocated
+ * one by one. Only these objects come from the arena: their QString and QList
+ * storage, and any other heap memory they own, stays on the heap and is freed
+ * by their destructors. With Qt 5 the nodes of a QList<T> of a generated type
+ * are created with T::operator new, so they also come from the arena.
+ *
+ * Deleting an arena object runs its destructor as usual but does not free
+ * memory. clear() destroys the objects that are still alive and releases all
+ * the blocks at once, so the arena must outlive every object it allocated.
+ * Outside of a scope the allocations fall back to a plain operator new, with
+ * no extra cost as long as no arena holds a block.
+ */
+class ObjectArena
+{
+public:
+	typedef void (*DestroyFunc)(void* pObject);
+
+	ObjectArena(int iBlockSize = 64 * 1024);
+	virtual ~ObjectArena();
+
+	// Destroy the objects still alive and release all the blocks
+	void clear();
+
+	static void* allocate(size_t iSize, DestroyFunc destroy);
+	static void release(void* pObject);
+	// Check if an arena is current for the calling thread
+	static bool isActive();
+
+	template<class T>
+	static void destroy(void* pObject)
+	{
+		static_cast<T*>(pObject)->~T();
+	}
+
+	// Make the arena current for the calling thread during the scope lifetime,
+	// a NULL arena keeps the arena of the enclosing scope
+	class Scope
+	{
+	public:
+		Scope(ObjectArena* pArena);
+		~Scope();
+
+	private:
+		ObjectArena* m_pPreviousArena;
+	};
+
+	// Allocate on the heap during the scope lifetime, whatever the enclosing scopes,
+	// for objects which must outlive the current arena
+	class HeapScope
+	{
+	public:
+		HeapScope();
+		~HeapScope();
+
+	private:
+		ObjectArena* m_pPreviousArena;
+	};
+
+private:
+	// Copy is forbidden
+	ObjectArena(const ObjectArena&);
+	ObjectArena& operator=(const ObjectArena&);
+
+	struct Header;
+	void* allocateInBlock(size_t iSize);
+
+	int m_iBlockSize;
+	QList<char*> m_listBlocks;
+	char* m_pCurrent;
+	char* m_pEnd;
+
+	Header* m_pFirstHeader;
+	Header* m_pLastHeader;
+};
+
+}
+
+#endif /* OBJECTARENA_H_ */
@@ -0,0 +1,192 @@
+/*
+ * OperationBatch.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef OPERATIONBATCH_H_
+#define OPERATIONBATCH_H_
+
+#include <algorithm>
+#include <utility>
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QList>
+#include <QVector>
+
+#include "Service.h"
+
+namespace SOAPERO {
+
+// Aggregate figures of a batch, latencies are in milliseconds
+struct BatchStatistics
+{
+	int iCount;
+	int iSuccessCount;
+	qint64 iElapsedTime;
+	double fThroughput; // Operations per second
+	double fAverageLatency;
+	qint64 iMedianLatency;
+	qint64 i95PercentileLatency;
+	qint64 iMaxLatency;
+};
+
+template<class Response, class Fault = NoFault>
+struct BatchResult
+{
+	bool bSuccess;
+	qint64 iLatency;
+	OperationResult result;
+	Response response;
+	Fault fault;
+};
+
+/*
+ * Run an asynchronous operation over a list of requests with at most iWindow
+ * queries in flight, in an event loop of the calling thread. The results are
+ * given back in the order of the requests.
+ *
+ * Used by the generated OpBatch() methods, the executor should implement
+ * IQueryExecutor::postQuery() for the queries to run concurrently.
+ */
+template<class S, class Request, class Response, class Fault = NoFault>
+class OperationBatch
+{
+public:
+	typedef void (S::*AsyncOperationFunc)(const Request&, IOperationCallback<Response, Fault>*);
+
+	static QList<BatchResult<Response, Fault> > run(S* pService, AsyncOperationFunc operation,
+			const QList<Request>& listRequests, int iWindow, BatchStatistics* pStatistics)
+	{
+		OperationBatch batch(pService, listRequests.size());
+		batch.exec(operation, listRequests, qMax(1, iWindow));
+		if(pStatistics){
+			batch.getStatistics(*pStatistics);
+		}
+		return batch.m_listResults;
+	}
+
+private:
+	class ItemCallback : public IOperationCallback<Response, Fault>
+	{
+	public:
+		ItemCallback()
+		{
+			m_pBatch = NULL;
+			m_iIndex = 0;
+		}
+
+		virtual void operationFinished(bool bSuccess, Response& response, Fault& fault)
+		{
+			m_pBatch->itemFinished(m_iIndex, bSuccess, response, fault);
+		}
+
+		OperationBatch* m_pBatch;
+		int m_iIndex;
+	};
+
+	OperationBatch(S* pService, int iCount)
+		: m_vectorCallbacks(iCount), m_vectorStartTimes(iCount)
+	{
+		m_pService = pService;
+		m_iPendingCount = 0;
+		for(int i = 0; i < iCount; ++i) {
+			m_listResults.append(BatchResult<Response, Fault>());
+			m_listResults.last().bSuccess = false;
+			m_listResults.last().iLatency = 0;
+		}
+	}
+
+	void exec(AsyncOperationFunc operation, const QList<Request>& listRequests, int iWindow)
+	{
+		m_timer.start();
+
+		// The callbacks do not send the next queries themselves, an executor completing
+		// synchronously would otherwise recurse once per request
+		int iNext = 0;
+		while(iNext < listRequests.size() || m_iPendingCount > 0) {
+			while(m_iPendingCount < iWindow && iNext < listRequests.size()) {
+				ItemCallback& callback = m_vectorCallbacks[iNext];
+				callback.m_pBatch = this;
+				callback.m_iIndex = iNext;
+				m_vectorStartTimes[iNext] = m_timer.elapsed();
+				m_iPendingCount++;
+				(m_pService->*operation)(listRequests.at(iNext), &callback);
+				iNext++;
+			}
+			if(m_iPendingCount > 0) {
+				m_loop.exec();
+			}
+		}
+
+		m_iElapsedTime = m_timer.elapsed();
+	}
+
+	void itemFinished(int iIndex, bool bSuccess, Response& response, Fault& fault)
+	{
+		BatchResult<Response, Fault>& result = m_listResults[iIndex];
+		result.bSuccess = bSuccess;
+		result.iLatency = m_timer.elapsed() - m_vectorStartTimes[iIndex];
+		result.result = m_pService->lastResult();
+#ifdef Q_COMPILER_RVALUE_REFS
+		result.response = std::move(response);
+		result.fault = std::move(fault);
+#else
+		result.response = response;
+		result.fault = fault;
+#endif
+
+		m_iPendingCount--;
+		m_loop.quit();
+	}
+
+	void getStatistics(BatchStatistics& statistics) const
+	{
+		QVector<qint64> vectorLatencies;
+		vectorLatencies.reserve(m_listResults.size());
+
+		statistics.iCount = m_listResults.size();
+		statistics.iSuccessCount = 0;
+		statistics.iElapsedTime = m_iElapsedTime;
+		statistics.fThroughput = (m_iElapsedTime > 0 ? (statistics.iCount * 1000.0) / m_iElapsedTime : 0.0);
+
+		qint64 iTotalLatency = 0;
+		typename QList<BatchResult<Response, Fault> >::const_iterator iter;
+		for(iter = m_listResults.constBegin(); iter != m_listResults.constEnd(); ++iter) {
+			if(iter->bSuccess) {
+				statistics.iSuccessCount++;
+			}
+			iTotalLatency += iter->iLatency;
+			vectorLatencies.append(iter->iLatency);
+		}
+		std::sort(vectorLatencies.begin(), vectorLatencies.end());
+
+		if(vectorLatencies.isEmpty()) {
+			statistics.fAverageLatency = 0.0;
+			statistics.iMedianLatency = 0;
+			statistics.i95PercentileLatency = 0;
+			statistics.iMaxLatency = 0;
+		}else{
+			statistics.fAverageLatency = (double)iTotalLatency / vectorLatencies.size();
+			statistics.iMedianLatency = vectorLatencies.at(vectorLatencies.size() / 2);
+			// Nearest rank
+			statistics.i95PercentileLatency = vectorLatencies.at((vectorLatencies.size() * 95 + 99) / 100 - 1);
+			statistics.iMaxLatency = vectorLatencies.last();
+		}
+	}
+
+	S* m_pService;
+	QList<BatchResult<Response, Fault> > m_listResults;
+	QVector<ItemCallback> m_vectorCallbacks;
+	QVector<qint64> m_vectorStartTimes;
+	int m_iPendingCount;
+	qint64 m_iElapsedTime;
+
+	QElapsedTimer m_timer;
+	QEventLoop m_loop;
+};
+
+}
+
+#endif /* OPERATIONBATCH_H_ */
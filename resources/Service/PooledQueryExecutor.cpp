@@ -0,0 +1,573 @@
+/*
+ * PooledQueryExecutor.cpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#include <string.h>
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QNetworkAccessManager>
+#include <QPointer>
+#include <QThread>
+#include <QTimerEvent>
+
+#if QT_VERSION >= QT_VERSION_CHECK(6,3,0)
+#include <QHttp1Configuration>
+#endif
+
+#include "PooledQueryExecutor.h"
+#include "ResponseInflater.h"
+
+namespace SOAPERO {
+
+struct PooledQueryExecutor::SharedState
+{
+	SharedState()
+	{
+		iMaxConnectionsPerHost = 6;
+		iIdleTimeout = 30000;
+		statistics.iManagerCount = 0;
+		statistics.iRequestCount = 0;
+		statistics.iActiveRequestCount = 0;
+		statistics.iMaxActiveRequestCount = 0;
+		statistics.iWaitCount = 0;
+		statistics.iEvictionCount = 0;
+	}
+
+	mutable QMutex mutex;
+	int iMaxConnectionsPerHost;
+	int iIdleTimeout;
+	Statistics statistics;
+	QHash<QThread*, ThreadPool*> hashPools;
+};
+
+// Network manager of a thread with its running replies. The idle check uses
+// QObject::timerEvent() so no meta object is needed. The pool is deleted in its
+// thread when the thread exits, or when the executor is deleted.
+class PooledQueryExecutor::ThreadPool : public QObject
+{
+public:
+	ThreadPool(const QSharedPointer<SharedState>& pState)
+		: m_pState(pState)
+	{
+		m_pThread = QThread::currentThread();
+		m_pManager = new QNetworkAccessManager();
+		m_bHasIdleConnections = false;
+		m_lastActivity.start();
+		startTimer(1000);
+
+		// The deferred deletions are done by Qt right after the finished signal
+		QObject::connect(m_pThread, &QThread::finished, this, &QObject::deleteLater, Qt::DirectConnection);
+
+		QMutexLocker locker(&m_pState->mutex);
+		m_pState->hashPools.insert(m_pThread, this);
+		m_pState->statistics.iManagerCount++;
+	}
+
+	virtual ~ThreadPool()
+	{
+		// Removed first so the executor destructor never sees a pool being deleted
+		{
+			QMutexLocker locker(&m_pState->mutex);
+			m_pState->hashPools.remove(m_pThread);
+			m_pState->statistics.iManagerCount--;
+		}
+
+		if(m_pManager) {
+			delete m_pManager;
+			m_pManager = NULL;
+		}
+	}
+
+	QNetworkAccessManager* getManager() const
+	{
+		return m_pManager;
+	}
+
+	int getActiveCount(const QString& szHost)
+	{
+		removeFinishedReplies();
+
+		int iCount = 0;
+		QList<QPointer<QNetworkReply> >::const_iterator iter;
+		for(iter = m_listReplies.constBegin(); iter != m_listReplies.constEnd(); ++iter) {
+			if(getHostKey((*iter)->url()) == szHost){
+				iCount++;
+			}
+		}
+		return iCount;
+	}
+
+	// Run the event loop until one of the replies to the host is finished
+	void waitForReply(const QString& szHost)
+	{
+		QEventLoop loop;
+		QList<QPointer<QNetworkReply> >::const_iterator iter;
+		for(iter = m_listReplies.constBegin(); iter != m_listReplies.constEnd(); ++iter) {
+			if(!iter->isNull() && getHostKey((*iter)->url()) == szHost){
+				QObject::connect(*iter, SIGNAL(finished()), &loop, SLOT(quit()));
+			}
+		}
+		loop.exec();
+	}
+
+	void addReply(QNetworkReply* pReply)
+	{
+		m_listReplies.append(pReply);
+		m_bHasIdleConnections = true;
+		m_lastActivity.restart();
+	}
+
+	void finishQuery()
+	{
+		m_lastActivity.restart();
+
+		QMutexLocker locker(&m_pState->mutex);
+		m_pState->statistics.iActiveRequestCount--;
+	}
+
+	void evictIdleConnections()
+	{
+		int iIdleTimeout;
+		{
+			QMutexLocker locker(&m_pState->mutex);
+			iIdleTimeout = m_pState->iIdleTimeout;
+		}
+
+		if(iIdleTimeout <= 0 || !m_bHasIdleConnections || m_lastActivity.elapsed() < iIdleTimeout) {
+			return;
+		}
+		removeFinishedReplies();
+		if(!m_listReplies.isEmpty()) {
+			return;
+		}
+
+#if QT_VERSION >= QT_VERSION_CHECK(5,9,0)
+		m_pManager->clearConnectionCache();
+#else
+		// Without clearConnectionCache() the only way is a new manager
+		delete m_pManager;
+		m_pManager = new QNetworkAccessManager();
+#endif
+		m_bHasIdleConnections = false;
+
+		QMutexLocker locker(&m_pState->mutex);
+		m_pState->statistics.iEvictionCount++;
+	}
+
+	static QString getHostKey(const QUrl& url)
+	{
+		return url.scheme() + "://" + url.host() + ":" + QString::number(url.port());
+	}
+
+protected:
+	virtual void timerEvent(QTimerEvent*)
+	{
+		evictIdleConnections();
+	}
+
+private:
+	void removeFinishedReplies()
+	{
+		QList<QPointer<QNetworkReply> >::iterator iter = m_listReplies.begin();
+		while(iter != m_listReplies.end()) {
+			if(iter->isNull() || (*iter)->isFinished()) {
+				iter = m_listReplies.erase(iter);
+			}else{
+				++iter;
+			}
+		}
+	}
+
+	QSharedPointer<SharedState> m_pState;
+	QThread* m_pThread;
+	QNetworkAccessManager* m_pManager;
+	QList<QPointer<QNetworkReply> > m_listReplies;
+	QElapsedTimer m_lastActivity;
+	bool m_bHasIdleConnections;
+};
+
+static const QByteArray g_contentEncodingHeader("Content-Encoding");
+
+// Status code, network error and content of a finished reply
+static IQueryExecutorResponse getReplyResponse(QNetworkReply* pReply, const QByteArray& data)
+{
+	IQueryExecutorResponse response;
+	QVariant statusCode = pReply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
+	if(statusCode.isValid()){
+		response.setHttpStatusCode(statusCode.toInt());
+	}
+	if(pReply->error() != QNetworkReply::NoError && !statusCode.isValid()){
+		response.setErrorString(pReply->errorString());
+	}
+	response.setResponse(data);
+	return response;
+}
+
+// Read the whole content of a finished reply, decoded if it is compressed
+static QByteArray readReplyContent(QNetworkReply* pReply)
+{
+	QByteArray data = pReply->readAll();
+	if(!ResponseInflater::inflateAll(pReply->rawHeader(g_contentEncodingHeader), data)){
+		qWarning("[PooledQueryExecutor] Error while inflating the response of %s", qPrintable(pReply->url().toString()));
+	}
+	return data;
+}
+
+// Sequential device over a network reply, a read waits in an event loop until
+// the next chunk is received so the response can be parsed during the transfer.
+// A gzip or deflate encoded reply is inflated chunk by chunk.
+class NetworkReplyDevice : public QIODevice
+{
+public:
+	NetworkReplyDevice(QNetworkReply* pReply)
+	{
+		m_pReply = pReply;
+		m_pInflater = NULL;
+		m_bEncodingChecked = false;
+		open(QIODevice::ReadOnly);
+	}
+
+	virtual ~NetworkReplyDevice()
+	{
+		if(m_pInflater) {
+			delete m_pInflater;
+			m_pInflater = NULL;
+		}
+		if(m_pReply) {
+			m_pReply->deleteLater();
+			m_pReply = NULL;
+		}
+	}
+
+	virtual bool isSequential() const
+	{
+		return true;
+	}
+
+	virtual qint64 bytesAvailable() const
+	{
+		if(m_pInflater) {
+			return m_inflatedData.size() + QIODevice::bytesAvailable();
+		}
+		return m_pReply->bytesAvailable() + QIODevice::bytesAvailable();
+	}
+
+	virtual bool atEnd() const
+	{
+		return m_pReply->isFinished() && m_pReply->bytesAvailable() == 0 && bytesAvailable() == 0;
+	}
+
+	void waitForFinished()
+	{
+		if(!m_pReply->isFinished()) {
+			QEventLoop loop;
+			QObject::connect(m_pReply, SIGNAL(finished()), &loop, SLOT(quit()));
+			loop.exec();
+		}
+		checkEncoding();
+		if(m_pInflater) {
+			m_data += m_inflatedData;
+			m_inflatedData.clear();
+			inflate(m_pReply->readAll(), m_data);
+		}else{
+			m_data += m_pReply->readAll();
+		}
+	}
+
+	IQueryExecutorResponse getResponse() const
+	{
+		return getReplyResponse(m_pReply, m_data);
+	}
+
+protected:
+	virtual qint64 readData(char* data, qint64 maxSize)
+	{
+		if(!m_bEncodingChecked) {
+			waitForData();
+			checkEncoding();
+		}
+
+		qint64 iRead;
+		if(m_pInflater) {
+			// A compressed chunk does not always give inflated data
+			while(m_inflatedData.isEmpty() && !m_pInflater->isFinished()) {
+				if(m_pReply->bytesAvailable() == 0) {
+					if(m_pReply->isFinished()) {
+						break;
+					}
+					waitForData();
+				}else if(!inflate(m_pReply->read(64 * 1024), m_inflatedData)) {
+					break;
+				}
+			}
+			iRead = qMin(maxSize, (qint64)m_inflatedData.size());
+			memcpy(data, m_inflatedData.constData(), (size_t)iRead);
+			m_inflatedData.remove(0, (int)iRead);
+		}else{
+			waitForData();
+			iRead = m_pReply->read(data, maxSize);
+		}
+
+		if(iRead > 0) {
+			// Kept for the debug output and the response given back by closeQuery()
+			m_data.append(data, (int)iRead);
+		}
+		return iRead;
+	}
+
+	virtual qint64 writeData(const char*, qint64)
+	{
+		return -1;
+	}
+
+private:
+	void waitForData()
+	{
+		if(m_pReply->bytesAvailable() == 0 && !m_pReply->isFinished()) {
+			QEventLoop loop;
+			QObject::connect(m_pReply, SIGNAL(readyRead()), &loop, SLOT(quit()));
+			QObject::connect(m_pReply, SIGNAL(finished()), &loop, SLOT(quit()));
+			loop.exec();
+		}
+	}
+
+	// The headers are known once the first data is received
+	void checkEncoding()
+	{
+		if(!m_bEncodingChecked) {
+			m_pInflater = ResponseInflater::create(m_pReply->rawHeader(g_contentEncodingHeader));
+			m_bEncodingChecked = true;
+		}
+	}
+
+	bool inflate(const QByteArray& input, QByteArray& output)
+	{
+		if(m_pInflater->inflateChunk(input, output)) {
+			return true;
+		}
+		// The parser stops on the truncated content
+		qWarning("[PooledQueryExecutor] Error while inflating the response of %s", qPrintable(m_pReply->url().toString()));
+		m_pReply->readAll();
+		return false;
+	}
+
+	QNetworkReply* m_pReply;
+	QByteArray m_data;
+	ResponseInflater* m_pInflater;
+	bool m_bEncodingChecked;
+	QByteArray m_inflatedData;
+};
+
+// Forward the end of a reply to the callback of postQuery(). Child of the
+// reply, it is deleted with it; the pointer to member connection does not
+// need a meta object.
+class PooledQueryExecutor::AsyncQuery : public QObject
+{
+public:
+	AsyncQuery(QNetworkReply* pReply, ThreadPool* pPool, IQueryCallback* pCallback)
+		: QObject(pReply)
+	{
+		m_pReply = pReply;
+		m_pPool = pPool;
+		m_pCallback = pCallback;
+		QObject::connect(pReply, &QNetworkReply::finished, this, &AsyncQuery::onFinished);
+	}
+
+	void onFinished()
+	{
+		IQueryExecutorResponse response = readResponse(m_pReply);
+		m_pReply->deleteLater();
+
+		m_pPool->finishQuery();
+		m_pCallback->queryFinished(response);
+	}
+
+private:
+	QNetworkReply* m_pReply;
+	ThreadPool* m_pPool;
+	IQueryCallback* m_pCallback;
+};
+
+PooledQueryExecutor::PooledQueryExecutor()
+	: m_pState(new SharedState())
+{
+
+}
+
+PooledQueryExecutor::~PooledQueryExecutor()
+{
+	QThread* pThread = QThread::currentThread();
+	ThreadPool* pLocalPool = NULL;
+	{
+		QMutexLocker locker(&m_pState->mutex);
+		if(m_pState->statistics.iActiveRequestCount > 0) {
+			qWarning("[PooledQueryExecutor] Deleted with %d queries running, they are aborted without calling their callbacks",
+					m_pState->statistics.iActiveRequestCount);
+		}
+
+		// A pool is deleted in its own thread, from its event loop or when the thread
+		// exits. It removes itself under the mutex, so the listed ones are still alive.
+		QHash<QThread*, ThreadPool*>::const_iterator iter;
+		for(iter = m_pState->hashPools.constBegin(); iter != m_pState->hashPools.constEnd(); ++iter) {
+			if(iter.key() == pThread) {
+				pLocalPool = iter.value();
+			}else{
+				iter.value()->deleteLater();
+			}
+		}
+	}
+
+	if(pLocalPool) {
+		delete pLocalPool;
+	}
+}
+
+void PooledQueryExecutor::setMaxConnectionsPerHost(int iMaxConnectionsPerHost)
+{
+	QMutexLocker locker(&m_pState->mutex);
+	m_pState->iMaxConnectionsPerHost = qMax(1, iMaxConnectionsPerHost);
+}
+
+int PooledQueryExecutor::getMaxConnectionsPerHost() const
+{
+	QMutexLocker locker(&m_pState->mutex);
+	return m_pState->iMaxConnectionsPerHost;
+}
+
+void PooledQueryExecutor::setIdleTimeout(int iIdleTimeout)
+{
+	QMutexLocker locker(&m_pState->mutex);
+	m_pState->iIdleTimeout = iIdleTimeout;
+}
+
+int PooledQueryExecutor::getIdleTimeout() const
+{
+	QMutexLocker locker(&m_pState->mutex);
+	return m_pState->iIdleTimeout;
+}
+
+PooledQueryExecutor::Statistics PooledQueryExecutor::getStatistics() const
+{
+	QMutexLocker locker(&m_pState->mutex);
+	return m_pState->statistics;
+}
+
+PooledQueryExecutor::ThreadPool* PooledQueryExecutor::getThreadPool()
+{
+	{
+		QMutexLocker locker(&m_pState->mutex);
+		ThreadPool* pPool = m_pState->hashPools.value(QThread::currentThread());
+		if(pPool) {
+			return pPool;
+		}
+	}
+	// Registered by its constructor
+	return new ThreadPool(m_pState);
+}
+
+QNetworkReply* PooledQueryExecutor::post(const QNetworkRequest& request, const QByteArray& bytes, bool bWaitForConnection)
+{
+	ThreadPool* pPool = getThreadPool();
+	pPool->evictIdleConnections();
+
+	int iMaxConnectionsPerHost;
+	{
+		QMutexLocker locker(&m_pState->mutex);
+		iMaxConnectionsPerHost = m_pState->iMaxConnectionsPerHost;
+	}
+
+	QString szHost = ThreadPool::getHostKey(request.url());
+	if(bWaitForConnection && pPool->getActiveCount(szHost) >= iMaxConnectionsPerHost) {
+		{
+			QMutexLocker locker(&m_pState->mutex);
+			m_pState->statistics.iWaitCount++;
+		}
+		do {
+			pPool->waitForReply(szHost);
+		} while(pPool->getActiveCount(szHost) >= iMaxConnectionsPerHost);
+	}
+
+	QNetworkRequest pooledRequest(request);
+	pooledRequest.setRawHeader("Connection", "keep-alive");
+#if QT_VERSION >= QT_VERSION_CHECK(6,3,0)
+	QHttp1Configuration http1Configuration;
+	http1Configuration.setNumberOfConnectionsPerHost(iMaxConnectionsPerHost);
+	pooledRequest.setHttp1Configuration(http1Configuration);
+#endif
+
+	QNetworkReply* pReply = pPool->getManager()->post(pooledRequest, bytes);
+	pPool->addReply(pReply);
+
+	QMutexLocker locker(&m_pState->mutex);
+	m_pState->statistics.iRequestCount++;
+	m_pState->statistics.iActiveRequestCount++;
+	if(m_pState->statistics.iActiveRequestCount > m_pState->statistics.iMaxActiveRequestCount) {
+		m_pState->statistics.iMaxActiveRequestCount = m_pState->statistics.iActiveRequestCount;
+	}
+
+	return pReply;
+}
+
+IQueryExecutorResponse PooledQueryExecutor::execQuery(const QNetworkRequest& request, const QByteArray& bytes)
+{
+	QNetworkReply* reply = post(request, bytes, true);
+	if(!reply->isFinished()) {
+		QEventLoop loop;
+		QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
+		loop.exec();
+	}
+
+	IQueryExecutorResponse response = readResponse(reply);
+	releaseQuery(reply);
+
+	return response;
+}
+
+QIODevice* PooledQueryExecutor::openQuery(const QNetworkRequest& request, const QByteArray& bytes)
+{
+	return new NetworkReplyDevice(post(request, bytes, true));
+}
+
+void PooledQueryExecutor::closeQuery(QIODevice* pDevice, IQueryExecutorResponse& response)
+{
+	NetworkReplyDevice* pReplyDevice = static_cast<NetworkReplyDevice*>(pDevice);
+	pReplyDevice->waitForFinished();
+	response = pReplyDevice->getResponse();
+	delete pReplyDevice;
+
+	getThreadPool()->finishQuery();
+}
+
+QNetworkReply* PooledQueryExecutor::sendQuery(const QNetworkRequest& request, const QByteArray& bytes)
+{
+	return post(request, bytes, false);
+}
+
+IQueryExecutorResponse PooledQueryExecutor::readResponse(QNetworkReply* pReply)
+{
+	return getReplyResponse(pReply, readReplyContent(pReply));
+}
+
+void PooledQueryExecutor::releaseQuery(QNetworkReply* pReply)
+{
+	if(!pReply->isFinished()) {
+		pReply->abort();
+	}
+	pReply->deleteLater();
+
+	getThreadPool()->finishQuery();
+}
+
+void PooledQueryExecutor::postQuery(const QNetworkRequest& request, const QByteArray& bytes, IQueryCallback* pCallback)
+{
+	QNetworkReply* pReply = post(request, bytes, false);
+	new AsyncQuery(pReply, getThreadPool(), pCallback);
+}
+
+}
@@ -0,0 +1,98 @@
+/*
+ * PooledQueryExecutor.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef POOLEDQUERYEXECUTOR_H_
+#define POOLEDQUERYEXECUTOR_H_
+
+#include <QNetworkReply>
+#include <QSharedPointer>
+
+#include "Service.h"
+
+namespace SOAPERO {
+
+/*
+ * Default query executor of the services. Each thread using the executor gets
+ * its own QNetworkAccessManager, created on its first query and kept until the
+ * thread exits, so the keep-alive connections opened by Qt are reused from one
+ * call to the next instead of paying a new TCP/TLS handshake every time.
+ *
+ * The number of simultaneous queries per host is limited for the blocking calls
+ * only: execQuery() or openQuery() called while the limit is reached waits for
+ * one of the running queries of the thread to finish. The asynchronous queries
+ * never wait, they are only queued by Qt, which opens at most 6 connections per
+ * host before Qt 6.3 and as many as the limit since.
+ *
+ * Connections idle for longer than the idle timeout are closed. The check runs
+ * from a timer and needs the thread event loop, it is also done before each
+ * query.
+ *
+ * Queries sent with postQuery() complete from the event loop of the thread, so
+ * one thread can keep many of them in flight.
+ *
+ * The executor can be used by several threads at once: the settings and the
+ * statistics are protected by a mutex, everything else is kept per thread.
+ * It must outlive its queries: the destructor deletes the network managers of
+ * all the threads, each one in its own thread, and a query still running is
+ * then aborted without calling its callback.
+ */
+class PooledQueryExecutor : public IQueryExecutor
+{
+public:
+	struct Statistics
+	{
+		int iManagerCount; // Network managers alive, one per thread
+		qint64 iRequestCount;
+		int iActiveRequestCount;
+		int iMaxActiveRequestCount;
+		qint64 iWaitCount; // Queries delayed by the connections per host limit
+		qint64 iEvictionCount; // Idle connection caches closed
+	};
+
+	PooledQueryExecutor();
+	virtual ~PooledQueryExecutor();
+
+	// Limit of the blocking queries per host in each thread, and of the connections
+	// opened by Qt for all the queries with Qt 6.3 or later
+	void setMaxConnectionsPerHost(int iMaxConnectionsPerHost);
+	int getMaxConnectionsPerHost() const;
+	// In milliseconds, 0 to keep the idle connections open
+	void setIdleTimeout(int iIdleTimeout);
+	int getIdleTimeout() const;
+
+	Statistics getStatistics() const;
+
+	virtual IQueryExecutorResponse execQuery(const QNetworkRequest& request, const QByteArray& bytes);
+	virtual QIODevice* openQuery(const QNetworkRequest& request, const QByteArray& bytes);
+	virtual void closeQuery(QIODevice* pDevice, IQueryExecutorResponse& response);
+	// Asynchronous queries do not wait for the connections per host limit, Qt queues them
+	virtual void postQuery(const QNetworkRequest& request, const QByteArray& bytes, IQueryCallback* pCallback);
+
+protected:
+	// Send a query without waiting for the connections per host limit, the reply is
+	// handled by the derived executor in the event loop of the thread
+	QNetworkReply* sendQuery(const QNetworkRequest& request, const QByteArray& bytes);
+	// Status code, network error and decoded content of a finished reply
+	static IQueryExecutorResponse readResponse(QNetworkReply* pReply);
+	// Release a reply given by sendQuery(), it is aborted if it is still running
+	void releaseQuery(QNetworkReply* pReply);
+
+private:
+	struct SharedState;
+	class ThreadPool;
+	class AsyncQuery;
+
+	ThreadPool* getThreadPool();
+	// Send the query, after waiting for a free connection to the host if requested
+	QNetworkReply* post(const QNetworkRequest& request, const QByteArray& bytes, bool bWaitForConnection);
+
+	// Shared with the thread pools which may outlive the executor
+	QSharedPointer<SharedState> m_pState;
+};
+
+}
+
+#endif /* POOLEDQUERYEXECUTOR_H_ */
@@ -0,0 +1,183 @@
+/*
+ * QueryRecording.cpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QUrl>
+
+#include "QueryRecording.h"
+#include "ResponseCache.h"
+#include "ResponseInflater.h"
+
+#define QUERYRECORDING_INDEX_FILENAME "index.jsonl"
+
+namespace SOAPERO {
+
+static bool writeFile(const QString& szFilePath, const QByteArray& data)
+{
+	QFile file(szFilePath);
+	if(!file.open(QFile::WriteOnly | QFile::Truncate)) {
+		return false;
+	}
+	return (file.write(data) == data.size());
+}
+
+static bool readFile(const QString& szFilePath, QByteArray& data)
+{
+	QFile file(szFilePath);
+	if(!file.open(QFile::ReadOnly)) {
+		return false;
+	}
+	data = file.readAll();
+	return true;
+}
+
+QueryRecording::QueryRecording(const QString& szDirPath)
+	: m_szDirPath(szDirPath)
+{
+	m_iLastId = 0;
+}
+
+QueryRecording::~QueryRecording()
+{
+
+}
+
+const QString& QueryRecording::getDirPath() const
+{
+	return m_szDirPath;
+}
+
+QString QueryRecording::getFilePath(const QString& szFilename) const
+{
+	return QDir(m_szDirPath).filePath(szFilename);
+}
+
+bool QueryRecording::create()
+{
+	QMutexLocker locker(&m_mutex);
+	if(!QDir().mkpath(m_szDirPath)) {
+		qWarning("[QueryRecording] Cannot create the directory %s", qPrintable(m_szDirPath));
+		return false;
+	}
+	m_iLastId = 0;
+	return writeFile(getFilePath(QUERYRECORDING_INDEX_FILENAME), QByteArray());
+}
+
+bool QueryRecording::append(Query& query)
+{
+	QMutexLocker locker(&m_mutex);
+	query.iId = ++m_iLastId;
+
+	QString szRequestFilename = QString("%1-request.xml").arg(query.iId, 6, 10, QChar('0'));
+	QString szResponseFilename = QString("%1-response.xml").arg(query.iId, 6, 10, QChar('0'));
+	if(!writeFile(getFilePath(szRequestFilename), query.request) ||
+			!writeFile(getFilePath(szResponseFilename), query.response)) {
+		qWarning("[QueryRecording] Cannot write the query %d in %s", query.iId, qPrintable(m_szDirPath));
+		return false;
+	}
+
+	QJsonObject object;
+	object.insert("id", query.iId);
+	object.insert("key", QString::fromLatin1(query.key.toHex()));
+	object.insert("url", query.szUrl);
+	object.insert("soapAction", QString::fromUtf8(query.soapAction));
+	object.insert("httpStatusCode", query.iHttpStatusCode);
+	object.insert("latency", (double)query.iLatency);
+	object.insert("request", szRequestFilename);
+	object.insert("response", szResponseFilename);
+
+	QFile file(getFilePath(QUERYRECORDING_INDEX_FILENAME));
+	if(!file.open(QFile::WriteOnly | QFile::Append)) {
+		qWarning("[QueryRecording] Cannot write the index of %s", qPrintable(m_szDirPath));
+		return false;
+	}
+	file.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+	file.write("\n");
+	return true;
+}
+
+bool QueryRecording::load()
+{
+	QMutexLocker locker(&m_mutex);
+	m_listQueries.clear();
+	m_hashQueryIndexes.clear();
+	m_hashNextQuery.clear();
+	m_iLastId = 0;
+
+	QFile file(getFilePath(QUERYRECORDING_INDEX_FILENAME));
+	if(!file.open(QFile::ReadOnly)) {
+		qWarning("[QueryRecording] Cannot read the index of %s", qPrintable(m_szDirPath));
+		return false;
+	}
+
+	bool bRes = true;
+	while(bRes && !file.atEnd()) {
+		QByteArray line = file.readLine().trimmed();
+		if(line.isEmpty()) {
+			continue;
+		}
+
+		QJsonObject object = QJsonDocument::fromJson(line).object();
+		Query query;
+		query.iId = object.value("id").toInt();
+		query.key = QByteArray::fromHex(object.value("key").toString().toLatin1());
+		query.szUrl = object.value("url").toString();
+		query.soapAction = object.value("soapAction").toString().toUtf8();
+		query.iHttpStatusCode = object.value("httpStatusCode").toInt();
+		query.iLatency = (qint64)object.value("latency").toDouble();
+		bRes = readFile(getFilePath(object.value("request").toString()), query.request) &&
+				readFile(getFilePath(object.value("response").toString()), query.response);
+		if(bRes) {
+			m_hashQueryIndexes[query.key].append(m_listQueries.size());
+			m_listQueries.append(query);
+			m_iLastId = qMax(m_iLastId, query.iId);
+		}else{
+			qWarning("[QueryRecording] Cannot read the query %d of %s", query.iId, qPrintable(m_szDirPath));
+		}
+	}
+	return bRes;
+}
+
+int QueryRecording::getQueryCount() const
+{
+	QMutexLocker locker(&m_mutex);
+	return (int)m_listQueries.size();
+}
+
+bool QueryRecording::findQuery(const QByteArray& key, Query& query)
+{
+	QMutexLocker locker(&m_mutex);
+	QHash<QByteArray, QList<int> >::const_iterator iter = m_hashQueryIndexes.constFind(key);
+	if(iter == m_hashQueryIndexes.constEnd()) {
+		return false;
+	}
+
+	int& iNext = m_hashNextQuery[key];
+	query = m_listQueries.at(iter->at(iNext));
+	iNext = (iNext + 1) % iter->size();
+	return true;
+}
+
+QByteArray QueryRecording::buildKey(const QByteArray& soapAction, const QByteArray& contentEncoding, const QByteArray& request)
+{
+	QByteArray decodedRequest = request;
+	if(!contentEncoding.isEmpty()) {
+		ResponseInflater::inflateAll(contentEncoding, decodedRequest);
+	}
+
+	// SOAP 1.1 clients may quote the action
+	QByteArray action = soapAction.trimmed();
+	if(action.size() >= 2 && action.startsWith('"') && action.endsWith('"')) {
+		action = action.mid(1, action.size() - 2);
+	}
+	return ResponseCache::buildKey(QUrl(), action.constData(), decodedRequest);
+}
+
+}
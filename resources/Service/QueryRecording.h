@@ -0,0 +1,81 @@
+/*
+ * QueryRecording.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef QUERYRECORDING_H_
+#define QUERYRECORDING_H_
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+namespace SOAPERO {
+
+/*
+ * Queries and responses recorded in a directory by RecordingQueryExecutor and
+ * served back by ReplayQueryExecutor or the ReplayServer example.
+ *
+ * Each query is kept in two files, NNNNNN-request.xml and NNNNNN-response.xml,
+ * listed in index.jsonl with one JSON object per line: id, key, url (without
+ * the credentials), soapAction, httpStatusCode, latency (in milliseconds),
+ * request and response file names.
+ *
+ * A query is found back by its key: a hash of the SOAP action and of the
+ * decoded message body, the SOAP header being left out as it changes with
+ * each WS-Security nonce.
+ */
+class QueryRecording
+{
+public:
+	struct Query
+	{
+		int iId;
+		QByteArray key;
+		QString szUrl;
+		QByteArray soapAction;
+		QByteArray request;
+		int iHttpStatusCode;
+		QByteArray response;
+		qint64 iLatency;
+	};
+
+	QueryRecording(const QString& szDirPath);
+	virtual ~QueryRecording();
+
+	const QString& getDirPath() const;
+
+	// Start a new recording in the directory, created if needed
+	bool create();
+	// Write a query of the recording and set its id, can be called from several threads
+	bool append(Query& query);
+
+	// Read the queries of the recording
+	bool load();
+	int getQueryCount() const;
+	// Copy the next response recorded for the key: the identical queries are answered in
+	// the recorded order, then again from the first one. Return false if there is none.
+	bool findQuery(const QByteArray& key, Query& query);
+
+	// The content encoding of the request is used to decode it
+	static QByteArray buildKey(const QByteArray& soapAction, const QByteArray& contentEncoding, const QByteArray& request);
+
+private:
+	QString getFilePath(const QString& szFilename) const;
+
+	QString m_szDirPath;
+
+	mutable QMutex m_mutex;
+	int m_iLastId;
+	QList<Query> m_listQueries;
+	// Indexes in the list of the queries of each key, and the next one to serve
+	QHash<QByteArray, QList<int> > m_hashQueryIndexes;
+	QHash<QByteArray, int> m_hashNextQuery;
+};
+
+}
+
+#endif /* QUERYRECORDING_H_ */
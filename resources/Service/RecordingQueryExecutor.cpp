@@ -0,0 +1,115 @@
+/*
+ * RecordingQueryExecutor.cpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#include <QMutexLocker>
+
+#include "RecordingQueryExecutor.h"
+
+namespace SOAPERO {
+
+// Record the response of a query sent with postQuery() before forwarding it
+class RecordingQueryExecutor::RecordingCallback : public IQueryCallback
+{
+public:
+	RecordingCallback(RecordingQueryExecutor* pExecutor, const PendingQuery& pendingQuery, IQueryCallback* pCallback)
+		: m_pendingQuery(pendingQuery)
+	{
+		m_pExecutor = pExecutor;
+		m_pCallback = pCallback;
+	}
+
+	virtual void queryFinished(const IQueryExecutorResponse& response)
+	{
+		m_pExecutor->finishQuery(m_pendingQuery, response);
+
+		IQueryCallback* pCallback = m_pCallback;
+		delete this;
+		pCallback->queryFinished(response);
+	}
+
+private:
+	RecordingQueryExecutor* m_pExecutor;
+	PendingQuery m_pendingQuery;
+	IQueryCallback* m_pCallback;
+};
+
+RecordingQueryExecutor::RecordingQueryExecutor(IQueryExecutor* pExecutor, const QString& szDirPath)
+	: m_recording(szDirPath)
+{
+	m_pExecutor = pExecutor;
+	m_recording.create();
+}
+
+RecordingQueryExecutor::~RecordingQueryExecutor()
+{
+	if(m_pExecutor) {
+		delete m_pExecutor;
+		m_pExecutor = NULL;
+	}
+}
+
+void RecordingQueryExecutor::startQuery(const QNetworkRequest& request, const QByteArray& bytes, PendingQuery& pendingQuery)
+{
+	QueryRecording::Query& query = pendingQuery.query;
+	query.iId = 0;
+	query.soapAction = request.rawHeader("SoapAction");
+	query.key = QueryRecording::buildKey(query.soapAction, request.rawHeader("Content-Encoding"), bytes);
+	query.szUrl = request.url().toString(QUrl::RemoveUserInfo);
+	query.request = bytes;
+	query.iHttpStatusCode = 0;
+	query.iLatency = 0;
+	pendingQuery.timer.start();
+}
+
+void RecordingQueryExecutor::finishQuery(PendingQuery& pendingQuery, const IQueryExecutorResponse& response)
+{
+	QueryRecording::Query& query = pendingQuery.query;
+	query.iLatency = pendingQuery.timer.elapsed();
+	query.iHttpStatusCode = response.getHttpStatusCode();
+	query.response = response.getResponse();
+	m_recording.append(query);
+}
+
+IQueryExecutorResponse RecordingQueryExecutor::execQuery(const QNetworkRequest& request, const QByteArray& bytes)
+{
+	PendingQuery pendingQuery;
+	startQuery(request, bytes, pendingQuery);
+	IQueryExecutorResponse response = m_pExecutor->execQuery(request, bytes);
+	finishQuery(pendingQuery, response);
+	return response;
+}
+
+QIODevice* RecordingQueryExecutor::openQuery(const QNetworkRequest& request, const QByteArray& bytes)
+{
+	PendingQuery pendingQuery;
+	startQuery(request, bytes, pendingQuery);
+	QIODevice* pDevice = m_pExecutor->openQuery(request, bytes);
+
+	QMutexLocker locker(&m_mutex);
+	m_hashPendingQueries.insert(pDevice, pendingQuery);
+	return pDevice;
+}
+
+void RecordingQueryExecutor::closeQuery(QIODevice* pDevice, IQueryExecutorResponse& response)
+{
+	PendingQuery pendingQuery;
+	{
+		QMutexLocker locker(&m_mutex);
+		pendingQuery = m_hashPendingQueries.take(pDevice);
+	}
+
+	m_pExecutor->closeQuery(pDevice, response);
+	finishQuery(pendingQuery, response);
+}
+
+void RecordingQueryExecutor::postQuery(const QNetworkRequest& request, const QByteArray& bytes, IQueryCallback* pCallback)
+{
+	PendingQuery pendingQuery;
+	startQuery(request, bytes, pendingQuery);
+	m_pExecutor->postQuery(request, bytes, new RecordingCallback(this, pendingQuery, pCallback));
+}
+
+}
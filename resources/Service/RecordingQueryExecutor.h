@@ -0,0 +1,60 @@
+/*
+ * RecordingQueryExecutor.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef RECORDINGQUERYEXECUTOR_H_
+#define RECORDINGQUERYEXECUTOR_H_
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+
+#include "QueryRecording.h"
+#include "Service.h"
+
+namespace SOAPERO {
+
+/*
+ * Query executor recording in a directory the queries sent through another
+ * executor, with their responses and latencies (see QueryRecording). The
+ * recording can then be served by ReplayQueryExecutor or the ReplayServer
+ * example to work on a client without the real endpoint.
+ *
+ *   service.setQueryExecutor(new RecordingQueryExecutor(new PooledQueryExecutor(), "./recording"));
+ */
+class RecordingQueryExecutor : public IQueryExecutor
+{
+public:
+	// The executor is owned, a new recording is started in the directory
+	RecordingQueryExecutor(IQueryExecutor* pExecutor, const QString& szDirPath);
+	virtual ~RecordingQueryExecutor();
+
+	virtual IQueryExecutorResponse execQuery(const QNetworkRequest& request, const QByteArray& bytes);
+	virtual QIODevice* openQuery(const QNetworkRequest& request, const QByteArray& bytes);
+	virtual void closeQuery(QIODevice* pDevice, IQueryExecutorResponse& response);
+	virtual void postQuery(const QNetworkRequest& request, const QByteArray& bytes, IQueryCallback* pCallback);
+
+private:
+	struct PendingQuery
+	{
+		QueryRecording::Query query;
+		QElapsedTimer timer;
+	};
+	class RecordingCallback;
+
+	static void startQuery(const QNetworkRequest& request, const QByteArray& bytes, PendingQuery& pendingQuery);
+	void finishQuery(PendingQuery& pendingQuery, const IQueryExecutorResponse& response);
+
+	IQueryExecutor* m_pExecutor;
+	QueryRecording m_recording;
+
+	QMutex m_mutex;
+	// Queries of the devices given by openQuery()
+	QHash<QIODevice*, PendingQuery> m_hashPendingQueries;
+};
+
+}
+
+#endif /* RECORDINGQUERYEXECUTOR_H_ */
@@ -0,0 +1,104 @@
+/*
+ * ReplayQueryExecutor.cpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#include <QEventLoop>
+#include <QTimer>
+#include <QTimerEvent>
+
+#include "ReplayQueryExecutor.h"
+
+namespace SOAPERO {
+
+// Response of postQuery() given from the event loop once the latency elapsed.
+// QObject::timerEvent() is used so no meta object is needed.
+class ReplayQueryExecutor::DelayedResponse : public QObject
+{
+public:
+	DelayedResponse(const IQueryExecutorResponse& response, IQueryCallback* pCallback, int iLatency)
+		: m_response(response)
+	{
+		m_pCallback = pCallback;
+		startTimer(iLatency);
+	}
+
+protected:
+	virtual void timerEvent(QTimerEvent* pEvent)
+	{
+		killTimer(pEvent->timerId());
+		deleteLater();
+		m_pCallback->queryFinished(m_response);
+	}
+
+private:
+	IQueryExecutorResponse m_response;
+	IQueryCallback* m_pCallback;
+};
+
+ReplayQueryExecutor::ReplayQueryExecutor(const QString& szDirPath)
+	: m_recording(szDirPath)
+{
+	m_fLatencyFactor = 0.0;
+	m_recording.load();
+}
+
+ReplayQueryExecutor::~ReplayQueryExecutor()
+{
+
+}
+
+void ReplayQueryExecutor::setLatencyFactor(double fLatencyFactor)
+{
+	m_fLatencyFactor = qMax(0.0, fLatencyFactor);
+}
+
+double ReplayQueryExecutor::getLatencyFactor() const
+{
+	return m_fLatencyFactor;
+}
+
+int ReplayQueryExecutor::getQueryCount() const
+{
+	return m_recording.getQueryCount();
+}
+
+IQueryExecutorResponse ReplayQueryExecutor::findResponse(const QNetworkRequest& request, const QByteArray& bytes, int& iLatency)
+{
+	IQueryExecutorResponse response;
+	iLatency = 0;
+
+	QueryRecording::Query query;
+	QByteArray key = QueryRecording::buildKey(request.rawHeader("SoapAction"), request.rawHeader("Content-Encoding"), bytes);
+	if(m_recording.findQuery(key, query)) {
+		response.setHttpStatusCode(query.iHttpStatusCode);
+		response.setResponse(query.response);
+		iLatency = (int)(query.iLatency * m_fLatencyFactor);
+	}else{
+		qWarning("[ReplayQueryExecutor] No recorded response for the query %s to %s", request.rawHeader("SoapAction").constData(), qPrintable(request.url().toString(QUrl::RemoveUserInfo)));
+		response.setErrorString("No recorded response for the query");
+	}
+	return response;
+}
+
+IQueryExecutorResponse ReplayQueryExecutor::execQuery(const QNetworkRequest& request, const QByteArray& bytes)
+{
+	int iLatency;
+	IQueryExecutorResponse response = findResponse(request, bytes, iLatency);
+	if(iLatency > 0) {
+		QEventLoop loop;
+		QTimer::singleShot(iLatency, &loop, SLOT(quit()));
+		loop.exec();
+	}
+	return response;
+}
+
+void ReplayQueryExecutor::postQuery(const QNetworkRequest& request, const QByteArray& bytes, IQueryCallback* pCallback)
+{
+	int iLatency;
+	IQueryExecutorResponse response = findResponse(request, bytes, iLatency);
+	new DelayedResponse(response, pCallback, iLatency);
+}
+
+}
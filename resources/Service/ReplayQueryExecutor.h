@@ -0,0 +1,52 @@
+/*
+ * ReplayQueryExecutor.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef REPLAYQUERYEXECUTOR_H_
+#define REPLAYQUERYEXECUTOR_H_
+
+#include "QueryRecording.h"
+#include "Service.h"
+
+namespace SOAPERO {
+
+/*
+ * Query executor answering the queries with the responses of a recording made
+ * by RecordingQueryExecutor, without any network access. The identical queries
+ * get the recorded responses in order, so a replay is deterministic.
+ *
+ * The recorded latencies can be simulated, scaled by a factor. The responses
+ * are given back after running the event loop of the thread for the latency,
+ * and always from the event loop for postQuery(), as with a real network.
+ * A query without recorded response fails with a network error.
+ */
+class ReplayQueryExecutor : public IQueryExecutor
+{
+public:
+	ReplayQueryExecutor(const QString& szDirPath);
+	virtual ~ReplayQueryExecutor();
+
+	// Factor applied to the recorded latencies, 0 (default) to answer immediately
+	void setLatencyFactor(double fLatencyFactor);
+	double getLatencyFactor() const;
+
+	int getQueryCount() const;
+
+	virtual IQueryExecutorResponse execQuery(const QNetworkRequest& request, const QByteArray& bytes);
+	virtual void postQuery(const QNetworkRequest& request, const QByteArray& bytes, IQueryCallback* pCallback);
+
+private:
+	class DelayedResponse;
+
+	// Find the response of the query and its simulated latency
+	IQueryExecutorResponse findResponse(const QNetworkRequest& request, const QByteArray& bytes, int& iLatency);
+
+	QueryRecording m_recording;
+	double m_fLatencyFactor;
+};
+
+}
+
+#endif /* REPLAYQUERYEXECUTOR_H_ */
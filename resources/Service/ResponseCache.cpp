@@ -0,0 +1,110 @@
+/*
+ * ResponseCache.cpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#include <QCryptographicHash>
+
+#include "ResponseCache.h"
+
+namespace SOAPERO {
+
+ResponseCache::Entry::Entry()
+{
+	iExpiryTime = 0;
+}
+
+ResponseCache::Entry::~Entry()
+{
+
+}
+
+ResponseCache::ResponseCache(int iMemoryBudget)
+	: m_cache(iMemoryBudget)
+{
+	m_clock.start();
+	m_statistics.iHitCount = 0;
+	m_statistics.iMissCount = 0;
+	m_statistics.iExpiredCount = 0;
+	m_statistics.iEntryCount = 0;
+	m_statistics.iMemorySize = 0;
+}
+
+ResponseCache::~ResponseCache()
+{
+
+}
+
+void ResponseCache::setMemoryBudget(int iMemoryBudget)
+{
+	QMutexLocker locker(&m_mutex);
+	m_cache.setMaxCost(iMemoryBudget);
+}
+
+int ResponseCache::getMemoryBudget() const
+{
+	QMutexLocker locker(&m_mutex);
+	return (int)m_cache.maxCost();
+}
+
+void ResponseCache::clear()
+{
+	QMutexLocker locker(&m_mutex);
+	m_cache.clear();
+}
+
+ResponseCache::Statistics ResponseCache::getStatistics() const
+{
+	QMutexLocker locker(&m_mutex);
+	Statistics statistics = m_statistics;
+	statistics.iEntryCount = (int)m_cache.count();
+	statistics.iMemorySize = (int)m_cache.totalCost();
+	return statistics;
+}
+
+QByteArray ResponseCache::buildKey(const QUrl& url, const char* szOperation, const QByteArray& soapMessage)
+{
+	static const QByteArray headerEnd("</s:Header>");
+
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(url.toEncoded());
+
+	int iBodyPos = soapMessage.indexOf(headerEnd);
+	if(iBodyPos < 0) {
+		hash.addData(soapMessage);
+	}else{
+		hash.addData(QByteArray::fromRawData(soapMessage.constData() + iBodyPos, soapMessage.size() - iBodyPos));
+	}
+
+	QByteArray key(szOperation);
+	key += ' ';
+	key += hash.result();
+	return key;
+}
+
+ResponseCache::Entry* ResponseCache::findEntry(const QByteArray& key)
+{
+	Entry* pEntry = m_cache.object(key);
+	if(pEntry && pEntry->iExpiryTime <= m_clock.elapsed()) {
+		m_cache.remove(key);
+		m_statistics.iExpiredCount++;
+		pEntry = NULL;
+	}
+
+	if(pEntry) {
+		m_statistics.iHitCount++;
+	}else{
+		m_statistics.iMissCount++;
+	}
+	return pEntry;
+}
+
+void ResponseCache::insertEntry(const QByteArray& key, Entry* pEntry, int iTtl)
+{
+	pEntry->iExpiryTime = m_clock.elapsed() + iTtl;
+	// The entry is deleted by the cache if it exceeds the budget
+	m_cache.insert(key, pEntry, 2 * pEntry->rawResponse.size() + key.size());
+}
+
+}
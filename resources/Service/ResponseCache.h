@@ -0,0 +1,128 @@
+/*
+ * ResponseCache.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef RESPONSECACHE_H_
+#define RESPONSECACHE_H_
+
+#include <QByteArray>
+#include <QCache>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QUrl>
+
+#include "ObjectArena.h"
+
+namespace SOAPERO {
+
+/*
+ * Cache of the responses of the read-only operations, shared by the services
+ * (see Service::setResponseCache() and Service::setOperationCacheTtl()). An
+ * entry keeps the parsed response and its raw bytes, so a hit skips both the
+ * query and the parsing.
+ *
+ * The memory budget is approximate: the cost of an entry is twice the size of
+ * its raw response, for the bytes and the parsed objects. The least recently
+ * used entries are removed when the budget is exceeded, the expired ones when
+ * they are looked up. The cache can be used by several threads at once.
+ */
+class ResponseCache
+{
+public:
+	struct Statistics
+	{
+		qint64 iHitCount;
+		qint64 iMissCount;
+		qint64 iExpiredCount;
+		int iEntryCount;
+		int iMemorySize;
+	};
+
+	// Budget in bytes
+	ResponseCache(int iMemoryBudget = 32 * 1024 * 1024);
+	virtual ~ResponseCache();
+
+	void setMemoryBudget(int iMemoryBudget);
+	int getMemoryBudget() const;
+
+	void clear();
+	Statistics getStatistics() const;
+
+	// Key of a query: operation and hash of the URL with its credentials and of the message
+	// body. The SOAP header is left out, it changes with each WS-Security nonce.
+	static QByteArray buildKey(const QUrl& url, const char* szOperation, const QByteArray& soapMessage);
+
+	// Copy the response of the key and its raw bytes, return false if there is none or it expired
+	template<class Response>
+	bool find(const QByteArray& key, Response& response, QByteArray* pRawResponse = NULL)
+	{
+		QMutexLocker locker(&m_mutex);
+		ObjectEntry<Response>* pEntry = dynamic_cast<ObjectEntry<Response>*>(findEntry(key));
+		if(!pEntry) {
+			return false;
+		}
+		response = pEntry->response;
+		if(pRawResponse) {
+			*pRawResponse = pEntry->rawResponse;
+		}
+		return true;
+	}
+
+	// Keep a copy of the response for iTtl milliseconds. The Qt containers are copied
+	// shallowly, so the response must not hold arena objects: the services parse the
+	// cached responses again on the heap (see Service::cacheResponse()).
+	template<class Response>
+	void insert(const QByteArray& key, const Response& response, const QByteArray& rawResponse, int iTtl)
+	{
+		ObjectEntry<Response>* pEntry;
+		{
+			// The items of the pointer lists are copied one by one, out of any arena
+			ObjectArena::HeapScope heapScope;
+			pEntry = new ObjectEntry<Response>(response);
+		}
+		pEntry->rawResponse = rawResponse;
+
+		QMutexLocker locker(&m_mutex);
+		insertEntry(key, pEntry, iTtl);
+	}
+
+private:
+	class Entry
+	{
+	public:
+		Entry();
+		virtual ~Entry();
+
+		qint64 iExpiryTime;
+		QByteArray rawResponse;
+	};
+
+	template<class Response>
+	class ObjectEntry : public Entry
+	{
+	public:
+		ObjectEntry(const Response& other)
+			: response(other)
+		{
+
+		}
+
+		Response response;
+	};
+
+	// Called with the mutex locked
+	Entry* findEntry(const QByteArray& key);
+	void insertEntry(const QByteArray& key, Entry* pEntry, int iTtl);
+
+	mutable QMutex m_mutex;
+	QCache<QByteArray, Entry> m_cache;
+	QElapsedTimer m_clock;
+	Statistics m_statistics;
+};
+
+}
+
+#endif /* RESPONSECACHE_H_ */
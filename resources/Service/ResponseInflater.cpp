@@ -0,0 +1,151 @@
+/*
+ * ResponseInflater.cpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifdef SOAPERO_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+#include "ResponseInflater.h"
+
+namespace SOAPERO {
+
+ResponseInflater::ResponseInflater()
+{
+	m_pStream = NULL;
+	m_bFinished = false;
+}
+
+ResponseInflater::~ResponseInflater()
+{
+#ifdef SOAPERO_WITH_ZLIB
+	if(m_pStream) {
+		z_stream* pStream = static_cast<z_stream*>(m_pStream);
+		inflateEnd(pStream);
+		delete pStream;
+		m_pStream = NULL;
+	}
+#endif
+}
+
+ResponseInflater* ResponseInflater::create(const QByteArray& contentEncoding)
+{
+#ifdef SOAPERO_WITH_ZLIB
+	QByteArray encoding = contentEncoding.trimmed().toLower();
+
+	int iWindowBits;
+	if(encoding == "gzip" || encoding == "x-gzip") {
+		// 15 window bits + 16 for the gzip header
+		iWindowBits = 15 + 16;
+	}else if(encoding == "deflate") {
+		// + 32 to detect the header, some servers send gzip for deflate
+		iWindowBits = 15 + 32;
+	}else{
+		return NULL;
+	}
+
+	z_stream* pStream = new z_stream;
+	pStream->zalloc = Z_NULL;
+	pStream->zfree = Z_NULL;
+	pStream->opaque = Z_NULL;
+	pStream->next_in = Z_NULL;
+	pStream->avail_in = 0;
+	pStream->next_out = Z_NULL;
+	pStream->avail_out = 0;
+	if(inflateInit2(pStream, iWindowBits) != Z_OK) {
+		delete pStream;
+		return NULL;
+	}
+
+	ResponseInflater* pInflater = new ResponseInflater();
+	pInflater->m_pStream = pStream;
+	return pInflater;
+#else
+	Q_UNUSED(contentEncoding);
+	return NULL;
+#endif
+}
+
+bool ResponseInflater::inflateChunk(const QByteArray& input, QByteArray& output)
+{
+#ifdef SOAPERO_WITH_ZLIB
+	const int iChunkSize = 64 * 1024;
+	z_stream* pStream = static_cast<z_stream*>(m_pStream);
+
+	pStream->next_in = (Bytef*)input.constData();
+	pStream->avail_in = (uInt)input.size();
+
+	// A full output chunk may leave inflated data in zlib even without input
+	while(!m_bFinished && (pStream->avail_in > 0 || pStream->avail_out == 0)) {
+		int iOffset = output.size();
+		output.resize(iOffset + iChunkSize);
+		pStream->next_out = (Bytef*)(output.data() + iOffset);
+		pStream->avail_out = iChunkSize;
+
+		int iRes = inflate(pStream, Z_NO_FLUSH);
+		output.resize(iOffset + iChunkSize - (int)pStream->avail_out);
+
+		if(iRes == Z_STREAM_END) {
+			m_bFinished = true;
+		}else if(iRes == Z_BUF_ERROR) {
+			// No progress possible, more input is needed
+			break;
+		}else if(iRes != Z_OK) {
+			return false;
+		}
+	}
+	return true;
+#else
+	Q_UNUSED(input);
+	Q_UNUSED(output);
+	return false;
+#endif
+}
+
+bool ResponseInflater::isFinished() const
+{
+	return m_bFinished;
+}
+
+bool ResponseInflater::inflateAll(const QByteArray& contentEncoding, QByteArray& data)
+{
+#ifndef SOAPERO_WITH_ZLIB
+	// The deflate encoding is a zlib stream, as written by qCompress() after the expected
+	// size which qUncompress() only uses as a first guess of the output size
+	if(contentEncoding.trimmed().toLower() == "deflate") {
+		quint32 iExpectedSize = (quint32)data.size() * 4;
+		QByteArray compressedData;
+		compressedData.reserve(data.size() + 4);
+		compressedData.append((char)((iExpectedSize >> 24) & 0xFF));
+		compressedData.append((char)((iExpectedSize >> 16) & 0xFF));
+		compressedData.append((char)((iExpectedSize >> 8) & 0xFF));
+		compressedData.append((char)(iExpectedSize & 0xFF));
+		compressedData.append(data);
+
+		QByteArray inflatedData = qUncompress(compressedData);
+		if(inflatedData.isEmpty() && !data.isEmpty()) {
+			return false;
+		}
+		data.swap(inflatedData);
+		return true;
+	}
+#endif
+
+	ResponseInflater* pInflater = create(contentEncoding);
+	if(!pInflater) {
+		return true;
+	}
+
+	QByteArray inflatedData;
+	bool bRes = pInflater->inflateChunk(data, inflatedData);
+	delete pInflater;
+
+	if(bRes) {
+		data.swap(inflatedData);
+	}
+	return bRes;
+}
+
+}
@@ -0,0 +1,53 @@
+/*
+ * ResponseInflater.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef RESPONSEINFLATER_H_
+#define RESPONSEINFLATER_H_
+
+#include <QByteArray>
+
+namespace SOAPERO {
+
+/*
+ * Streaming zlib decoder of the gzip or deflate encoded responses. The chunks
+ * are inflated as they are received so the parser gets the decoded content
+ * without waiting for the whole response.
+ *
+ * Decoding needs SOAPERO_WITH_ZLIB to be defined and zlib to be linked, which
+ * the CMake option of the same name does, on by default when zlib is found.
+ * Without it the services do not ask for encoded responses and the network
+ * manager decodes them itself.
+ */
+class ResponseInflater
+{
+public:
+	// Return NULL for an identity encoding, an unknown one or without zlib
+	static ResponseInflater* create(const QByteArray& contentEncoding);
+	virtual ~ResponseInflater();
+
+	// Inflate a chunk of the response at the end of the output, return false if the stream is corrupt
+	bool inflateChunk(const QByteArray& input, QByteArray& output);
+	// The end of the compressed stream has been reached
+	bool isFinished() const;
+
+	// Inflate a whole response or request in place, return false if the stream is corrupt.
+	// Without zlib the deflate encoding is still decoded, with qUncompress().
+	static bool inflateAll(const QByteArray& contentEncoding, QByteArray& data);
+
+private:
+	ResponseInflater();
+	// Copy is forbidden
+	ResponseInflater(const ResponseInflater&);
+	ResponseInflater& operator=(const ResponseInflater&);
+
+	// z_stream, zlib.h is only included by the source file
+	void* m_pStream;
+	bool m_bFinished;
+};
+
+}
+
+#endif /* RESPONSEINFLATER_H_ */
@@ -13,16 +13,27 @@
 #endif
 
 #include <QCryptographicHash>
-#include <QEventLoop>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
+#include <QSet>
+#include <QThread>
 
+// Added in Qt 5.15.0
+#if QT_VERSION >= QT_VERSION_CHECK(5,15,0)
+#define USE_QRANDOMGENERATOR
+#endif
+
+#ifdef USE_QRANDOMGENERATOR
+#include <QRandomGenerator>
+#endif
+
+#ifdef SOAPERO_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+#include "PooledQueryExecutor.h"
 #include "Service.h"
 
 namespace SOAPERO {
 
-IQueryExecutor::IQueryExecutor(){}
-IQueryExecutor::~IQueryExecutor(){}
 
 IQueryExecutorResponse::IQueryExecutorResponse()
 {
@@ -54,36 +65,194 @@ int IQueryExecutorResponse::getHttpStatusCode() const
 	return m_iHttpStatusCode;
 }
 
-class CustomQueryExecutor : public IQueryExecutor
+void IQueryExecutorResponse::setErrorString(const QString& szErrorString)
 {
-public:
-	virtual IQueryExecutorResponse execQuery(const QNetworkRequest& request, const QByteArray& bytes)
-	{
-		IQueryExecutorResponse response;
-		QNetworkAccessManager *manager = new QNetworkAccessManager();
-		QNetworkReply *reply = manager->post(request, bytes);
-		QEventLoop loop;
-		QObject::connect(reply, SIGNAL(finished()), &loop, SLOT(quit()));
-		loop.exec();
-
-		QVariant statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
-		if(statusCode.isValid()){
-			response.setHttpStatusCode(statusCode.toInt());
-		}
-		response.setResponse(reply->readAll());
+	m_szErrorString = szErrorString;
+}
 
-		if(manager) {
-			delete manager;
-			manager = NULL;
-		}
+const QString& IQueryExecutorResponse::getErrorString() const
+{
+	return m_szErrorString;
+}
 
-		if(reply) {
-			reply->deleteLater();
-		}
+OperationResult::OperationResult()
+{
+	m_iStatus = StatusNotRun;
+	m_bFromCache = false;
+	m_iHttpStatusCode = 0;
+	m_iRequestSize = 0;
+	m_iSentRequestSize = 0;
+	m_iResponseSize = 0;
+	m_iPrepareTime = 0;
+	m_iTotalTime = 0;
+}
+
+OperationResult::~OperationResult()
+{
+
+}
+
+OperationResult::Status OperationResult::getStatus() const
+{
+	return m_iStatus;
+}
+
+bool OperationResult::isSuccess() const
+{
+	return (m_iStatus == StatusSuccess);
+}
+
+bool OperationResult::isFromCache() const
+{
+	return m_bFromCache;
+}
+
+const QString& OperationResult::getError() const
+{
+	return m_szError;
+}
+
+int OperationResult::getHttpStatusCode() const
+{
+	return m_iHttpStatusCode;
+}
+
+qint64 OperationResult::getRequestSize() const
+{
+	return m_iRequestSize;
+}
+
+qint64 OperationResult::getSentRequestSize() const
+{
+	return m_iSentRequestSize;
+}
+
+double OperationResult::getCompressionRatio() const
+{
+	if(m_iRequestSize == 0){
+		return 1.0;
+	}
+	return (double)m_iSentRequestSize / m_iRequestSize;
+}
+
+qint64 OperationResult::getResponseSize() const
+{
+	return m_iResponseSize;
+}
 
-		return response;
+qint64 OperationResult::getPrepareTime() const
+{
+	return m_iPrepareTime;
+}
+
+qint64 OperationResult::getTotalTime() const
+{
+	return m_iTotalTime;
+}
+
+void OperationResult::start()
+{
+	m_iStatus = StatusSuccess;
+	m_timer.start();
+}
+
+void OperationResult::setRequestPrepared(qint64 iRequestSize)
+{
+	m_iRequestSize = iRequestSize;
+	m_iSentRequestSize = iRequestSize;
+	m_iPrepareTime = m_timer.nsecsElapsed() / 1000;
+}
+
+void OperationResult::setRequestCompressed(qint64 iSentRequestSize)
+{
+	m_iSentRequestSize = iSentRequestSize;
+	m_iPrepareTime = m_timer.nsecsElapsed() / 1000;
+}
+
+void OperationResult::setSoapFault()
+{
+	m_iStatus = StatusSoapFault;
+	m_szError = "SOAP fault";
+}
+
+void OperationResult::setParseError(const QString& szError)
+{
+	if(m_iStatus == StatusSuccess){
+		m_iStatus = StatusParseError;
+		m_szError = szError;
+	}
+}
+
+void OperationResult::setResponse(const IQueryExecutorResponse& response)
+{
+	m_iHttpStatusCode = response.getHttpStatusCode();
+	m_iResponseSize = response.getResponse().size();
+	m_iTotalTime = m_timer.nsecsElapsed() / 1000;
+
+	// A SOAP fault is usually sent with an HTTP error status
+	if(m_iStatus != StatusSoapFault && m_iHttpStatusCode != 200){
+		if(m_iHttpStatusCode == 0){
+			m_iStatus = StatusNetworkError;
+			m_szError = response.getErrorString();
+		}else{
+			m_iStatus = StatusHttpError;
+			m_szError = QString("HTTP status code %1").arg(m_iHttpStatusCode);
+		}
 	}
-};
+}
+
+void OperationResult::setCachedResponse(const QByteArray& rawResponse)
+{
+	m_bFromCache = true;
+	m_iHttpStatusCode = 200;
+	m_iResponseSize = rawResponse.size();
+	m_iTotalTime = m_timer.nsecsElapsed() / 1000;
+}
+
+QueryResponseBuffer::QueryResponseBuffer(const IQueryExecutorResponse& response)
+	: m_response(response)
+{
+	setData(m_response.getResponse());
+	open(QIODevice::ReadOnly);
+}
+
+QueryResponseBuffer::~QueryResponseBuffer()
+{
+
+}
+
+const IQueryExecutorResponse& QueryResponseBuffer::getResponse() const
+{
+	return m_response;
+}
+
+IQueryCallback::IQueryCallback(){}
+IQueryCallback::~IQueryCallback(){}
+
+IQueryExecutor::IQueryExecutor(){}
+IQueryExecutor::~IQueryExecutor(){}
+
+QIODevice* IQueryExecutor::openQuery(const QNetworkRequest& request, const QByteArray& bytes)
+{
+	return new QueryResponseBuffer(execQuery(request, bytes));
+}
+
+void IQueryExecutor::closeQuery(QIODevice* pDevice, IQueryExecutorResponse& response)
+{
+	QueryResponseBuffer* pBuffer = static_cast<QueryResponseBuffer*>(pDevice);
+	response = pBuffer->getResponse();
+	delete pBuffer;
+}
+
+void IQueryExecutor::postQuery(const QNetworkRequest& request, const QByteArray& bytes, IQueryCallback* pCallback)
+{
+	pCallback->queryFinished(execQuery(request, bytes));
+}
+
+void NoFault::deserialize(QXmlStreamReader& reader)
+{
+	reader.skipCurrentElement();
+}
 
 #ifdef _MSC_VER
 	static int p_gettimeofday(struct timeval* p, void* tz)
@@ -112,29 +281,86 @@ public:
 #define p_gettimeofday gettimeofday
 #endif
 
-Service::Service()
+#ifdef SOAPERO_WITH_ZLIB
+// Compress to the gzip format by chunks, the output only grows by the compressed size
+static bool gzipCompress(const QByteArray& input, QByteArray& output)
 {
-	m_iLastErrorCode = -1;
-	m_pQueryExecutor = new CustomQueryExecutor();
-	m_bUseWSUsernameToken = false;
-	m_bUseCustomDateTime = false;
+	z_stream stream;
+	stream.zalloc = Z_NULL;
+	stream.zfree = Z_NULL;
+	stream.opaque = Z_NULL;
+	// 15 window bits + 16 for the gzip header
+	if(deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK){
+		return false;
+	}
+
+	const int iChunkSize = 64 * 1024;
+	stream.next_in = (Bytef*)input.constData();
+	stream.avail_in = (uInt)input.size();
+
+	int iRes;
+	do {
+		int iOffset = output.size();
+		output.resize(iOffset + iChunkSize);
+		stream.next_out = (Bytef*)(output.data() + iOffset);
+		stream.avail_out = iChunkSize;
+		iRes = deflate(&stream, Z_FINISH);
+		output.resize(iOffset + iChunkSize - (int)stream.avail_out);
+	} while(iRes == Z_OK);
+
+	deflateEnd(&stream);
+	return (iRes == Z_STREAM_END);
+}
+#endif
+
+// Random generator of the calling thread, seeded on its first use in the thread
 #ifdef USE_QRANDOMGENERATOR
-	// Initialize random number based on time with nano second precision.
-	// This be be sure to don't have
-	struct timeval tvNow;
-	p_gettimeofday(&tvNow, NULL);
-	quint64 iSec = (quint64)tvNow.tv_sec;
-	quint64 iUSec = (quint64)tvNow.tv_usec;
-	quint32 listSeedValue[4];
-	listSeedValue[0] = (iSec >> 32);
-	listSeedValue[1] = (iSec & 0xFFFFFFFF);
-	listSeedValue[2] = (iUSec >> 32);
-	listSeedValue[3] = (iUSec & 0xFFFFFFFF);
-	m_rand = QRandomGenerator(listSeedValue, 4);
+static QThreadStorage<QRandomGenerator*> g_randomGenerators;
+
+static QRandomGenerator* getThreadRandomGenerator()
+{
+	if(!g_randomGenerators.hasLocalData()) {
+		// Initialize random number based on time with micro second precision and
+		// the thread, to be sure to don't have the same sequence in two threads.
+		struct timeval tvNow;
+		p_gettimeofday(&tvNow, NULL);
+		quint64 iSec = (quint64)tvNow.tv_sec;
+		quint64 iUSec = (quint64)tvNow.tv_usec;
+		quint64 iThread = (quint64)(quintptr)QThread::currentThreadId();
+		quint32 listSeedValue[6];
+		listSeedValue[0] = (iSec >> 32);
+		listSeedValue[1] = (iSec & 0xFFFFFFFF);
+		listSeedValue[2] = (iUSec >> 32);
+		listSeedValue[3] = (iUSec & 0xFFFFFFFF);
+		listSeedValue[4] = (iThread >> 32);
+		listSeedValue[5] = (iThread & 0xFFFFFFFF);
+		g_randomGenerators.setLocalData(new QRandomGenerator(listSeedValue, 6));
+	}
+	return g_randomGenerators.localData();
+}
 #else
-	uint iSeed = (uint)(QDateTime::currentMSecsSinceEpoch() & 0xFFFFFFFF);
-	qsrand(iSeed);
+// qrand() keeps its seed per thread
+static QThreadStorage<bool> g_randomSeeded;
+
+static void seedThreadRandom()
+{
+	if(!g_randomSeeded.hasLocalData()) {
+		uint iSeed = (uint)(QDateTime::currentMSecsSinceEpoch() & 0xFFFFFFFF);
+		iSeed ^= (uint)(quintptr)QThread::currentThreadId();
+		qsrand(iSeed);
+		g_randomSeeded.setLocalData(true);
+	}
+}
 #endif
+
+Service::Service()
+{
+	m_pQueryExecutor = new PooledQueryExecutor();
+	m_pObjectArena = NULL;
+	m_iRequestCompressionThreshold = -1;
+	m_pResponseCache = NULL;
+	m_bUseWSUsernameToken = false;
+	m_bUseCustomDateTime = false;
 }
 
 Service::~Service()
@@ -171,14 +397,52 @@ void Service::setQueryExecutor(IQueryExecutor* pExecutor)
 
 }
 
+void Service::setObjectArena(ObjectArena* pArena)
+{
+	m_pObjectArena = pArena;
+}
+
+void Service::setRequestCompressionThreshold(int iThreshold)
+{
+	m_iRequestCompressionThreshold = iThreshold;
+}
+
+void Service::setResponseCache(ResponseCache* pCache)
+{
+	m_pResponseCache = pCache;
+}
+
+void Service::setOperationCacheTtl(const QString& szOperation, int iTtl)
+{
+	m_hashOperationCacheTtl.insert(szOperation, iTtl);
+}
+
+int Service::getOperationCacheTtl(const QString& szOperation) const
+{
+	if(!m_pResponseCache) {
+		return 0;
+	}
+	return m_hashOperationCacheTtl.value(szOperation, 0);
+}
+
+const OperationResult& Service::lastResult() const
+{
+	return m_lastResults.localData();
+}
+
 int Service::lastErrorCode() const
 {
-	return m_iLastErrorCode;
+	return (int)lastResult().getStatus();
 }
 
 const QString& Service::lastError() const
 {
-	return m_szLastError;
+	return lastResult().getError();
+}
+
+void Service::setLastResult(const OperationResult& result) const
+{
+	m_lastResults.setLocalData(result);
 }
 
 QNetworkRequest Service::buildNetworkRequest() const
@@ -187,35 +451,72 @@ QNetworkRequest Service::buildNetworkRequest() const
 	return request;
 }
 
+void Service::setSoapHeaders(QNetworkRequest& request, const QByteArray& contentType, const QByteArray& soapAction) const
+{
+	static const QByteArray contentTypeHeader("Content-Type");
+	static const QByteArray soapActionHeader("SoapAction");
+
+	request.setRawHeader(contentTypeHeader, contentType);
+#ifdef SOAPERO_WITH_ZLIB
+	// Decoded by the executor with ResponseInflater. Without it the header is left to the
+	// network manager, which only decodes the responses when it sets the header itself.
+	static const QByteArray acceptEncodingHeader("Accept-Encoding");
+	static const QByteArray acceptEncoding("gzip, deflate");
+	request.setRawHeader(acceptEncodingHeader, acceptEncoding);
+#endif
+	request.setRawHeader(soapActionHeader, soapAction);
+}
+
 QByteArray Service::buildSoapMessage(const QString& szSerializedObject, const QList<QString>& listNamespaceDeclaration) const
 {
-	QString szDatetime;
-	if(m_bUseCustomDateTime){
-		szDatetime = m_customDateTime.toString(Qt::ISODate);
-	}else{
-		szDatetime = QDateTime::currentDateTime().toString(Qt::ISODate);
-	}
-	QString szNonce = buildNonce();
-	QByteArray szNonce64 = szNonce.toLatin1().toBase64();
-	QByteArray digestbytes = szNonce.toLatin1();
-	digestbytes.append(szDatetime.toLatin1());
-	digestbytes.append(m_url.password().toLatin1());
-	QString szDigestPassword = QString(QCryptographicHash::hash(digestbytes, QCryptographicHash::Sha1).toBase64());
+	QByteArray bytes;
+	startSoapMessage(bytes, listNamespaceDeclaration);
+	bytes += szSerializedObject.toUtf8();
+	endSoapMessage(bytes);
+	return bytes;
+}
 
-	QString szNamespaceTmp;
-	QList<QString> listNamespaceDeclarationCopy = listNamespaceDeclaration;
-	QString szNamespaceDeclaration = " xmlns:s=\"http://www.w3.org/2003/05/soap-envelope\"";
-	while(!listNamespaceDeclarationCopy.empty()){
-		szNamespaceTmp = listNamespaceDeclarationCopy.first();
-		szNamespaceDeclaration += " " + szNamespaceTmp;
-		listNamespaceDeclarationCopy.removeAll(szNamespaceTmp);
+QByteArray Service::buildSoapEnvelopePrefix(const QList<QString>& listNamespaceDeclaration)
+{
+	QByteArray bytes = "<s:Envelope xmlns:s=\"http://www.w3.org/2003/05/soap-envelope\"";
+
+	QSet<QString> setNamespaceDeclaration;
+	QList<QString>::const_iterator iter;
+	for(iter = listNamespaceDeclaration.constBegin(); iter != listNamespaceDeclaration.constEnd(); ++iter) {
+		if(!setNamespaceDeclaration.contains(*iter)) {
+			setNamespaceDeclaration.insert(*iter);
+			bytes += ' ';
+			bytes += iter->toUtf8();
+		}
 	}
+	bytes += '>';
+	return bytes;
+}
 
-	QByteArray bytes;
-	bytes += "<s:Envelope" + szNamespaceDeclaration.toUtf8() + ">";
+void Service::startSoapMessage(QByteArray& bytes, const QList<QString>& listNamespaceDeclaration) const
+{
+	startSoapMessage(bytes, buildSoapEnvelopePrefix(listNamespaceDeclaration));
+}
+
+void Service::startSoapMessage(QByteArray& bytes, const QByteArray& envelopePrefix) const
+{
+	bytes += envelopePrefix;
 	bytes +=     "<s:Header>";
 	if(m_bUseWSUsernameToken){
 		if(!m_url.userName().isEmpty() && !m_url.password().isEmpty()){
+			QString szDatetime;
+			if(m_bUseCustomDateTime){
+				szDatetime = m_customDateTime.toString(Qt::ISODate);
+			}else{
+				szDatetime = QDateTime::currentDateTime().toString(Qt::ISODate);
+			}
+			QString szNonce = buildNonce();
+			QByteArray szNonce64 = szNonce.toLatin1().toBase64();
+			QByteArray digestbytes = szNonce.toLatin1();
+			digestbytes.append(szDatetime.toLatin1());
+			digestbytes.append(m_url.password().toLatin1());
+			QString szDigestPassword = QString(QCryptographicHash::hash(digestbytes, QCryptographicHash::Sha1).toBase64());
+
 			bytes +=         "<Security s:mustUnderstand=\"1\" xmlns=\"http://docs.oasis-open.org/wss/2004/01/oasis-200401-wss-wssecurity-secext-1.0.xsd\">";
 			bytes +=             "<UsernameToken>";
 			bytes +=                 "<Username>" + m_url.userName().toUtf8() + "</Username>";
@@ -228,10 +529,66 @@ QByteArray Service::buildSoapMessage(const QString& szSerializedObject, const QL
 	}
 	bytes +=     "</s:Header>";
 	bytes +=     "<s:Body xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" xmlns:xsd=\"http://www.w3.org/2001/XMLSchema\">";
-	bytes +=		szSerializedObject.toUtf8();
+}
+
+void Service::endSoapMessage(QByteArray& bytes) const
+{
 	bytes +=     "</s:Body>";
 	bytes += "</s:Envelope>";
-	return bytes;
+}
+
+void Service::compressSoapMessage(QNetworkRequest& request, QByteArray& soapMessage, OperationResult& result) const
+{
+	static const QByteArray contentEncodingHeader("Content-Encoding");
+
+	if(m_iRequestCompressionThreshold < 0 || soapMessage.size() < m_iRequestCompressionThreshold){
+		return;
+	}
+
+	QByteArray compressedMessage;
+#ifdef SOAPERO_WITH_ZLIB
+	if(!gzipCompress(soapMessage, compressedMessage)){
+		return;
+	}
+	request.setRawHeader(contentEncodingHeader, "gzip");
+#else
+	// qCompress() gives the zlib format used by the deflate encoding, after a 4 bytes size
+	compressedMessage = qCompress(soapMessage);
+	compressedMessage.remove(0, 4);
+	request.setRawHeader(contentEncodingHeader, "deflate");
+#endif
+	soapMessage.swap(compressedMessage);
+	result.setRequestCompressed(soapMessage.size());
+}
+
+bool Service::readSoapBodyContent(QXmlStreamReader& reader) const
+{
+	if(!reader.readNextStartElement() || !isSoapEnvelopeElement(reader, "Envelope")) {
+		return false;
+	}
+
+	// Header is skipped without being parsed
+	while(reader.readNextStartElement()) {
+		if(isSoapEnvelopeElement(reader, "Body")) {
+			return reader.readNextStartElement();
+		}
+		reader.skipCurrentElement();
+	}
+	return false;
+}
+
+bool Service::isSoapFault(const QXmlStreamReader& reader) const
+{
+	return isSoapEnvelopeElement(reader, "Fault");
+}
+
+bool Service::isSoapEnvelopeElement(const QXmlStreamReader& reader, const char* szName)
+{
+	if(reader.name() != QLatin1String(szName)) {
+		return false;
+	}
+	return (reader.namespaceUri() == QLatin1String("http://www.w3.org/2003/05/soap-envelope")) ||
+			(reader.namespaceUri() == QLatin1String("http://schemas.xmlsoap.org/soap/envelope/"));
 }
 
 QString Service::buildNonce() const
@@ -239,10 +596,16 @@ QString Service::buildNonce() const
 	QString szPossibleCharacters("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789");
 	int iRandomStringLength = 20;
 
+#ifdef USE_QRANDOMGENERATOR
+	QRandomGenerator* pRand = getThreadRandomGenerator();
+#else
+	seedThreadRandom();
+#endif
+
 	QString szRandomString;
 	for(int i=0; i<iRandomStringLength; ++i) {
 #ifdef USE_QRANDOMGENERATOR
-		int index = (int)(m_rand.generate() % szPossibleCharacters.length());
+		int index = (int)(pRand->generate() % szPossibleCharacters.length());
 #else
 		int index = qrand() % szPossibleCharacters.length();
 #endif
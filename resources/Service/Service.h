@@ -9,20 +9,20 @@
 #define SERVICE_H_
 
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QString>
+#include <QThreadStorage>
 #include <QByteArray>
+#include <QBuffer>
+#include <QIODevice>
 #include <QUrl>
+#include <QXmlStreamReader>
 
 #include <QNetworkRequest>
 
-// Added in Qt 5.15.0
-#if QT_VERSION >= QT_VERSION_CHECK(5,15,0)
-#define USE_QRANDOMGENERATOR
-#endif
-
-#ifdef USE_QRANDOMGENERATOR
-#include <QRandomGenerator>
-#endif
+#include "ObjectArena.h"
+#include "ResponseCache.h"
 
 namespace SOAPERO {
 
@@ -38,9 +38,93 @@ public:
 	void setHttpStatusCode(int iHttpStatusCode);
 	int getHttpStatusCode() const;
 
+	// Network error of the query, empty if the server was reached
+	void setErrorString(const QString& szErrorString);
+	const QString& getErrorString() const;
+
 private:
 	QByteArray m_response;
 	int m_iHttpStatusCode;
+	QString m_szErrorString;
+};
+
+// Outcome of one call to a generated operation, times are in microseconds
+class OperationResult
+{
+public:
+	enum Status {
+		StatusNotRun = -1,
+		StatusSuccess = 0,
+		StatusNetworkError,
+		StatusHttpError,
+		StatusParseError,
+		StatusSoapFault
+	};
+
+public:
+	OperationResult();
+	virtual ~OperationResult();
+
+	Status getStatus() const;
+	bool isSuccess() const;
+	// The response comes from the response cache
+	bool isFromCache() const;
+	const QString& getError() const;
+	int getHttpStatusCode() const;
+	qint64 getRequestSize() const;
+	// Size of the request body sent, smaller than the request when it is compressed
+	qint64 getSentRequestSize() const;
+	double getCompressionRatio() const;
+	qint64 getResponseSize() const;
+	// Time spent serializing the request
+	qint64 getPrepareTime() const;
+	// Time from the start of the call to the end of the response
+	qint64 getTotalTime() const;
+
+	// Used by the generated operations
+	void start();
+	void setRequestPrepared(qint64 iRequestSize);
+	void setRequestCompressed(qint64 iSentRequestSize);
+	void setSoapFault();
+	void setParseError(const QString& szError);
+	// A network or HTTP error replaces a parse error, it is the cause of it
+	void setResponse(const IQueryExecutorResponse& response);
+	void setCachedResponse(const QByteArray& rawResponse);
+
+private:
+	Status m_iStatus;
+	bool m_bFromCache;
+	QString m_szError;
+	int m_iHttpStatusCode;
+	qint64 m_iRequestSize;
+	qint64 m_iSentRequestSize;
+	qint64 m_iResponseSize;
+	qint64 m_iPrepareTime;
+	qint64 m_iTotalTime;
+	QElapsedTimer m_timer;
+};
+
+// Device over a response already received, returned by the default IQueryExecutor::openQuery()
+class QueryResponseBuffer : public QBuffer
+{
+public:
+	QueryResponseBuffer(const IQueryExecutorResponse& response);
+	virtual ~QueryResponseBuffer();
+
+	const IQueryExecutorResponse& getResponse() const;
+
+private:
+	IQueryExecutorResponse m_response;
+};
+
+// Completion of a query sent with IQueryExecutor::postQuery()
+class IQueryCallback
+{
+public:
+	IQueryCallback();
+	virtual ~IQueryCallback();
+
+	virtual void queryFinished(const IQueryExecutorResponse& response) = 0;
 };
 
 class IQueryExecutor
@@ -49,9 +133,52 @@ public:
 	IQueryExecutor();
 	virtual ~IQueryExecutor();
 
+	// With SOAPERO_WITH_ZLIB (CMake option of the generated service) the requests accept gzip
+	// and deflate encoded responses, the executor must give back the decoded content (see
+	// ResponseInflater)
 	virtual IQueryExecutorResponse execQuery(const QNetworkRequest& request, const QByteArray& bytes) = 0;
+
+	// Send the query and return a device to read the response while it is received.
+	// The default implementation reads the whole response with execQuery().
+	virtual QIODevice* openQuery(const QNetworkRequest& request, const QByteArray& bytes);
+	// Wait for the end of the query, fill the response and release the device
+	virtual void closeQuery(QIODevice* pDevice, IQueryExecutorResponse& response);
+	// Send the query without waiting for the response, the callback is called from the
+	// event loop of the calling thread and is not owned. The default implementation
+	// runs execQuery() and calls the callback before returning.
+	virtual void postQuery(const QNetworkRequest& request, const QByteArray& bytes, IQueryCallback* pCallback);
 };
 
+// Fault type of the asynchronous operations without a SOAP fault, the fault is skipped
+class NoFault
+{
+public:
+	void deserialize(QXmlStreamReader& reader);
+};
+
+// Completion of a generated asynchronous operation. bSuccess is false on a network,
+// HTTP or parsing error and on a SOAP fault. The response and fault can be moved from.
+template<class Response, class Fault = NoFault>
+class IOperationCallback
+{
+public:
+	virtual ~IOperationCallback() {}
+
+	virtual void operationFinished(bool bSuccess, Response& response, Fault& fault) = 0;
+};
+
+/*
+ * Base class of the generated services.
+ *
+ * The operations keep no state in the service: the outcome of each call is
+ * given back in an OperationResult and kept per thread, the nonces come from a
+ * random generator per thread and the default executor has a network manager
+ * per thread. Once configured, a service can then be shared by a pool of
+ * worker threads. The setters are not thread-safe and must be called before
+ * the service is shared, the executor and the arena set must be thread-safe
+ * themselves (an ObjectArena is not, leave it unset and open an
+ * ObjectArena::Scope in each thread instead).
+ */
 class Service
 {
 public:
@@ -59,33 +186,147 @@ public:
 	virtual ~Service();
 
 	void setBaseUrl(const QUrl& url);
+	// A new nonce is built for each query, the queries sent again as they are by an executor
+	// (see HedgedQueryExecutor) may be rejected as replayed
 	void setUseWSUsernameToken(bool bUseWSUsernameToken);
 	void setCustomDateTime(const QDateTime& customDateTime);
 	void setQueryExecutor(IQueryExecutor* pExecutor);
+	// Allocate the objects of the following responses in the arena (NULL to use the heap or
+	// the arena of an enclosing ObjectArena::Scope). The arena is not owned and must outlive
+	// the responses.
+	void setObjectArena(ObjectArena* pArena);
+	// Compress the request bodies of at least iThreshold bytes, -1 to disable (default).
+	// The body is sent with gzip when SOAPERO_WITH_ZLIB is defined and zlib linked, with
+	// deflate through qCompress() otherwise. The server must accept the Content-Encoding.
+	void setRequestCompressionThreshold(int iThreshold);
+	// Keep the successful responses of the operations with a TTL in the cache (NULL to
+	// disable). The cache is not owned and can be shared with other services.
+	void setResponseCache(ResponseCache* pCache);
+	// Time to live of the cached responses of an operation in milliseconds, 0 to not cache it.
+	// The read-only operations can also be given a TTL at generation time.
+	void setOperationCacheTtl(const QString& szOperation, int iTtl);
 
+	// Result of the last operation finished in the calling thread
+	const OperationResult& lastResult() const;
 	int lastErrorCode() const;
 	const QString& lastError() const;
 
 protected:
 	QNetworkRequest buildNetworkRequest() const;
+	void setSoapHeaders(QNetworkRequest& request, const QByteArray& contentType, const QByteArray& soapAction) const;
 	QByteArray buildSoapMessage(const QString& szSerializedObject, const QList<QString>& listNamespaceDeclaration) const;
+	// Opening Envelope tag with its namespace declarations, built once per operation
+	static QByteArray buildSoapEnvelopePrefix(const QList<QString>& listNamespaceDeclaration);
+	// Write the envelope around an object serialized directly in the same buffer
+	void startSoapMessage(QByteArray& bytes, const QList<QString>& listNamespaceDeclaration) const;
+	void startSoapMessage(QByteArray& bytes, const QByteArray& envelopePrefix) const;
+	void endSoapMessage(QByteArray& bytes) const;
+	// Compress the message according to the threshold and set the Content-Encoding header
+	void compressSoapMessage(QNetworkRequest& request, QByteArray& soapMessage, OperationResult& result) const;
+	// Move the reader to the first element inside the SOAP body, return false if there is none
+	bool readSoapBodyContent(QXmlStreamReader& reader) const;
+	// Check if the current element is a SOAP 1.1 or 1.2 Fault
+	bool isSoapFault(const QXmlStreamReader& reader) const;
+	void setLastResult(const OperationResult& result) const;
+	// Time to live of the cached responses of the operation, 0 if it is not cached
+	int getOperationCacheTtl(const QString& szOperation) const;
+
+	// Keep the response in the cache. A response parsed in an arena shares its objects
+	// with any copy, so the cached one is parsed again from the raw bytes on the heap.
+	template<class Response>
+	void cacheResponse(const QByteArray& key, const Response& response, const QByteArray& rawResponse, int iTtl) const
+	{
+		if(!m_pObjectArena && !ObjectArena::isActive()){
+			m_pResponseCache->insert(key, response, rawResponse, iTtl);
+			return;
+		}
+
+		ObjectArena::HeapScope heapScope;
+		Response cachedResponse;
+		QXmlStreamReader reader(rawResponse);
+		if(readSoapBodyContent(reader) && !isSoapFault(reader)){
+			cachedResponse.deserialize(reader);
+		}
+		if(!reader.hasError()){
+			m_pResponseCache->insert(key, cachedResponse, rawResponse, iTtl);
+		}
+	}
 
 	QUrl m_url;
 	bool m_bUseWSUsernameToken;
 	bool m_bUseCustomDateTime;
 	QDateTime m_customDateTime;
 
-	int m_iLastErrorCode;
-	QString m_szLastError;
-
 	IQueryExecutor* m_pQueryExecutor;
+	ObjectArena* m_pObjectArena;
+	int m_iRequestCompressionThreshold;
+	ResponseCache* m_pResponseCache;
+	QHash<QString, int> m_hashOperationCacheTtl;
 
 private:
 	QString buildNonce() const;
+	// Compare the local name and resolved namespace URI with the SOAP 1.1 and 1.2 envelope namespaces
+	static bool isSoapEnvelopeElement(const QXmlStreamReader& reader, const char* szName);
+
+	template<class Response, class Fault> friend class AsyncOperation;
+
+	mutable QThreadStorage<OperationResult> m_lastResults;
+};
 
-#ifdef USE_QRANDOMGENERATOR
-	mutable QRandomGenerator m_rand;
-#endif
+// Parse the response of an asynchronous operation and forward it to the operation callback.
+// Created by the generated operations, it deletes itself once the callback is called so the
+// service must outlive the pending operations. The result of the operation is the last
+// result of the thread during the callback.
+template<class Response, class Fault>
+class AsyncOperation : public IQueryCallback
+{
+public:
+	AsyncOperation(const Service* pService, IOperationCallback<Response, Fault>* pCallback, const OperationResult& result,
+			const QByteArray& cacheKey = QByteArray(), int iCacheTtl = 0)
+		: m_result(result), m_cacheKey(cacheKey)
+	{
+		m_pService = pService;
+		m_pCallback = pCallback;
+		m_iCacheTtl = iCacheTtl;
+	}
+
+	virtual void queryFinished(const IQueryExecutorResponse& response)
+	{
+		Response output;
+		Fault fault;
+		{
+			QXmlStreamReader reader(response.getResponse());
+			ObjectArena::Scope arenaScope(m_pService->m_pObjectArena);
+			if(m_pService->readSoapBodyContent(reader)){
+				if(m_pService->isSoapFault(reader)){
+					fault.deserialize(reader);
+					m_result.setSoapFault();
+				}else{
+					output.deserialize(reader);
+				}
+			}
+			if(reader.hasError()){
+				m_result.setParseError(reader.errorString());
+			}
+		}
+		m_result.setResponse(response);
+		m_pService->setLastResult(m_result);
+		if(m_iCacheTtl > 0 && m_result.isSuccess()){
+			m_pService->cacheResponse(m_cacheKey, output, response.getResponse(), m_iCacheTtl);
+		}
+
+		IOperationCallback<Response, Fault>* pCallback = m_pCallback;
+		bool bSuccess = m_result.isSuccess();
+		delete this;
+		pCallback->operationFinished(bSuccess, output, fault);
+	}
+
+private:
+	const Service* m_pService;
+	IOperationCallback<Response, Fault>* m_pCallback;
+	OperationResult m_result;
+	QByteArray m_cacheKey;
+	int m_iCacheTtl;
 };
 
 }
@@ -0,0 +1,297 @@
+/*
+ * TypeDescriptor.cpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#include <string.h>
+
+#include "NameHash.h"
+#include "TypeDescriptor.h"
+
+namespace SOAPERO {
+
+QString TypeSerializer::serialize(const TypeDescriptor& descriptor, const void* pObject, bool bOnlyContent)
+{
+	QByteArray buffer;
+	serialize(descriptor, pObject, buffer, bOnlyContent);
+	return QString::fromUtf8(buffer);
+}
+
+void TypeSerializer::serialize(const TypeDescriptor& descriptor, const void* pObject, QByteArray& buffer, bool bOnlyContent)
+{
+	if(descriptor.serialize){
+		descriptor.serialize(pObject, buffer, bOnlyContent);
+		return;
+	}
+
+	if(!bOnlyContent) {
+		appendTag(buffer, "<", descriptor.szNamespace, descriptor.szName);
+	}
+	appendContent(descriptor, pObject, buffer);
+	if(!bOnlyContent) {
+		appendTag(buffer, "</", descriptor.szNamespace, descriptor.szName);
+		buffer += '>';
+	}
+}
+
+void TypeSerializer::deserialize(const TypeDescriptor& descriptor, void* pObject, QDomElement& element)
+{
+	deserializeContent(descriptor, pObject, element);
+}
+
+void TypeSerializer::deserialize(const TypeDescriptor& descriptor, void* pObject, QXmlStreamReader& reader)
+{
+	if(descriptor.read){
+		descriptor.read(pObject, reader);
+		return;
+	}
+
+	// Attributes must be read before the reader moves past the start element
+	deserializeAttributes(descriptor, pObject, reader.attributes());
+
+	if(descriptor.pBaseValueDescriptor){
+		descriptor.pBaseValueDescriptor->read(descriptor.toBase(pObject), reader);
+		return;
+	}
+
+	while(reader.readNextStartElement()) {
+		if(!deserializeElement(descriptor, pObject, reader)) {
+			reader.skipCurrentElement();
+		}
+	}
+}
+
+void TypeSerializer::deserializeAttributes(const TypeDescriptor& descriptor, void* pObject, const QXmlStreamAttributes& attributes)
+{
+	const FieldDescriptor* pField;
+
+	if(descriptor.readAttributes){
+		descriptor.readAttributes(pObject, attributes);
+		return;
+	}
+
+	if(descriptor.pBaseTypeDescriptor){
+		deserializeAttributes(*descriptor.pBaseTypeDescriptor, descriptor.toBase(pObject), attributes);
+	}
+
+	for(int i = 0; i < attributes.size(); ++i) {
+		const QXmlStreamAttribute& attr = attributes.at(i);
+		for(int j = 0; j < descriptor.iFieldCount; ++j) {
+			pField = &descriptor.pFields[j];
+			if((pField->iFlags & FieldDescriptor::FlagAttribute) && attr.name() == QLatin1String(pField->szName)) {
+				pField->readAttribute(pField->append(pObject), attr);
+				break;
+			}
+		}
+	}
+}
+
+bool TypeSerializer::deserializeElement(const TypeDescriptor& descriptor, void* pObject, QXmlStreamReader& reader)
+{
+	return deserializeElement(descriptor, pObject, reader, nameHash(reader.name()));
+}
+
+bool TypeSerializer::deserializeElement(const TypeDescriptor& descriptor, void* pObject, QXmlStreamReader& reader, quint32 iNameHash)
+{
+	const FieldDescriptor* pField;
+	void* pItem;
+
+	if(descriptor.readElement){
+		return descriptor.readElement(pObject, reader);
+	}
+
+	// Same matching as the generated switch: hash, then local name, local elements
+	// being either unqualified or in the target namespace
+	for(int i = 0; i < descriptor.iFieldCount; ++i) {
+		pField = &descriptor.pFields[i];
+		if((pField->iFlags & FieldDescriptor::FlagAttribute) || pField->iNameHash != iNameHash) {
+			continue;
+		}
+		if(pField->szNamespaceUri && !reader.namespaceUri().isEmpty() && reader.namespaceUri() != QLatin1String(pField->szNamespaceUri)) {
+			continue;
+		}
+
+		if(reader.name() == QLatin1String(pField->szName)) {
+			pItem = pField->append(pObject);
+			if(pField->pTypeDescriptor) {
+				deserialize(*pField->pTypeDescriptor, pItem, reader);
+			}else{
+				pField->pValueDescriptor->read(pItem, reader);
+			}
+			return true;
+		}
+	}
+
+	// Fall back on the fields of the base class
+	if(descriptor.pBaseTypeDescriptor){
+		return deserializeElement(*descriptor.pBaseTypeDescriptor, descriptor.toBase(pObject), reader, iNameHash);
+	}
+	return false;
+}
+
+void TypeSerializer::appendContent(const TypeDescriptor& descriptor, const void* pObject, QByteArray& buffer)
+{
+	if(descriptor.serialize){
+		descriptor.serialize(pObject, buffer, true);
+		return;
+	}
+
+	appendAttributes(descriptor, pObject, buffer);
+
+	// Content of the base class, attributes included, is written after the own attributes
+	if(descriptor.pBaseTypeDescriptor){
+		appendContent(*descriptor.pBaseTypeDescriptor, descriptor.toConstBase(pObject), buffer);
+	}else{
+		buffer += '>';
+		if(descriptor.pBaseValueDescriptor){
+			buffer += descriptor.pBaseValueDescriptor->serialize(descriptor.toConstBase(pObject)).toUtf8();
+		}
+	}
+
+	appendElements(descriptor, pObject, buffer);
+}
+
+void TypeSerializer::appendAttributes(const TypeDescriptor& descriptor, const void* pObject, QByteArray& buffer)
+{
+	const FieldDescriptor* pField;
+	const void* pItem;
+
+	for(int i = 0; i < descriptor.iFieldCount; ++i) {
+		pField = &descriptor.pFields[i];
+		if(!(pField->iFlags & FieldDescriptor::FlagAttribute)) {
+			continue;
+		}
+
+		pItem = pField->item(pObject, 0);
+		if(!pField->pValueDescriptor->isNull(pItem)) {
+			buffer += ' ';
+			buffer += pField->szName;
+			buffer += "=\"";
+			buffer += pField->pValueDescriptor->serialize(pItem).toUtf8();
+			buffer += '"';
+		}
+	}
+}
+
+void TypeSerializer::appendElements(const TypeDescriptor& descriptor, const void* pObject, QByteArray& buffer)
+{
+	const FieldDescriptor* pField;
+	const TypeDescriptor* pTypeDescriptor;
+	const void* pItem;
+	int iCount;
+
+	for(int i = 0; i < descriptor.iFieldCount; ++i) {
+		pField = &descriptor.pFields[i];
+		if(pField->iFlags & FieldDescriptor::FlagAttribute) {
+			continue;
+		}
+
+		iCount = pField->count(pObject);
+		for(int j = 0; j < iCount; ++j) {
+			pItem = pField->item(pObject, j);
+			if(!pItem) {
+				continue;
+			}
+
+			pTypeDescriptor = pField->pTypeDescriptor;
+			if(pTypeDescriptor) {
+				if(pTypeDescriptor->isNull(pItem)) {
+					continue;
+				}
+				if(pField->iFlags & FieldDescriptor::FlagSelfTagged) {
+					serialize(*pTypeDescriptor, pItem, buffer, false);
+				}else{
+					appendTag(buffer, "<", descriptor.szNamespace, pField->szName);
+					appendContent(*pTypeDescriptor, pItem, buffer);
+					appendTag(buffer, "</", descriptor.szNamespace, pField->szName);
+					buffer += '>';
+				}
+			}else{
+				if(pField->pValueDescriptor->isNull(pItem)) {
+					continue;
+				}
+				appendTag(buffer, "<", descriptor.szNamespace, pField->szName);
+				buffer += '>';
+				buffer += pField->pValueDescriptor->serialize(pItem).toUtf8();
+				appendTag(buffer, "</", descriptor.szNamespace, pField->szName);
+				buffer += '>';
+			}
+		}
+	}
+}
+
+void TypeSerializer::appendTag(QByteArray& buffer, const char* szPrefix, const char* szNamespace, const char* szName)
+{
+	buffer += szPrefix;
+	buffer += szNamespace;
+	buffer += ':';
+	buffer += szName;
+}
+
+void TypeSerializer::deserializeContent(const TypeDescriptor& descriptor, void* pObject, QDomElement& element)
+{
+	const FieldDescriptor* pField;
+	void* pItem;
+
+	if(descriptor.deserialize){
+		descriptor.deserialize(pObject, element);
+		return;
+	}
+
+	if(descriptor.pBaseTypeDescriptor){
+		deserializeContent(*descriptor.pBaseTypeDescriptor, descriptor.toBase(pObject), element);
+	}else if(descriptor.pBaseValueDescriptor){
+		descriptor.pBaseValueDescriptor->deserialize(descriptor.toBase(pObject), element);
+	}
+
+	for(int i = 0; i < descriptor.iFieldCount; ++i) {
+		pField = &descriptor.pFields[i];
+		if(!(pField->iFlags & FieldDescriptor::FlagAttribute)) {
+			continue;
+		}
+
+		QDomAttr attr = element.attributeNode(QLatin1String(pField->szName));
+		if(!attr.isNull()) {
+			pField->deserializeAttribute(pField->append(pObject), attr);
+		}
+	}
+
+	QDomElement child = element.firstChild().toElement();
+	while(!child.isNull()) {
+		pField = findElementField(descriptor, child.tagName());
+		if(pField) {
+			pItem = pField->append(pObject);
+			if(pField->pTypeDescriptor) {
+				deserializeContent(*pField->pTypeDescriptor, pItem, child);
+			}else{
+				pField->pValueDescriptor->deserialize(pItem, child);
+			}
+		}
+		child = child.nextSibling().toElement();
+	}
+}
+
+const FieldDescriptor* TypeSerializer::findElementField(const TypeDescriptor& descriptor, const QString& szTagName)
+{
+	const FieldDescriptor* pField;
+	int iNameLength;
+
+	// Compare on the local name, prefixes are not resolved in the DOM
+	int iLocalNameLength = szTagName.length() - (szTagName.indexOf(QLatin1Char(':')) + 1);
+
+	for(int i = 0; i < descriptor.iFieldCount; ++i) {
+		pField = &descriptor.pFields[i];
+		if(pField->iFlags & FieldDescriptor::FlagAttribute) {
+			continue;
+		}
+
+		iNameLength = (int)strlen(pField->szName);
+		if(iNameLength == iLocalNameLength && szTagName.endsWith(QLatin1String(pField->szName))) {
+			return pField;
+		}
+	}
+	return NULL;
+}
+
+}
@@ -0,0 +1,297 @@
+/*
+ * TypeDescriptor.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef TYPEDESCRIPTOR_H_
+#define TYPEDESCRIPTOR_H_
+
+#include <QByteArray>
+#include <QDomElement>
+#include <QList>
+#include <QString>
+#include <QXmlStreamReader>
+
+namespace SOAPERO {
+
+/*
+ * Description tables used by the generated classes when the generator is run
+ * with --serialization-mode=Table. Each generated class exposes a static
+ * TypeDescriptor listing its attributes and elements, and TypeSerializer walks
+ * those tables instead of running a serialize/deserialize body unrolled for
+ * every class.
+ *
+ * All tables are aggregates initialized with address constants only, so they
+ * are filled at load time and do not suffer from static initialization order.
+ */
+
+struct TypeDescriptor;
+
+typedef QString (*ValueSerializeFunc)(const void* pValue);
+typedef void (*ValueDeserializeFunc)(void* pValue, const QDomElement& element);
+typedef void (*ValueDeserializeAttributeFunc)(void* pValue, const QDomAttr& attr);
+typedef bool (*ValueIsNullFunc)(const void* pValue);
+typedef void (*ValueReadFunc)(void* pValue, QXmlStreamReader& reader);
+typedef void (*ValueReadAttributeFunc)(void* pValue, const QXmlStreamAttribute& attr);
+
+// Operations of a simple value (XS type or generated simple type)
+struct ValueDescriptor
+{
+	ValueSerializeFunc serialize;
+	ValueDeserializeFunc deserialize;
+	ValueIsNullFunc isNull;
+	ValueReadFunc read;
+};
+
+typedef int (*FieldCountFunc)(const void* pObject);
+typedef const void* (*FieldItemFunc)(const void* pObject, int iIndex);
+typedef void* (*FieldAppendFunc)(void* pObject);
+
+struct FieldDescriptor
+{
+	enum Flags {
+		FlagElement = 0x00,
+		FlagAttribute = 0x01,
+		FlagSelfTagged = 0x02 // Items are written with the tag of their own type
+	};
+
+	const char* szName;
+	quint32 iNameHash; // nameHash() of the name, compared before the name itself
+	const char* szNamespaceUri; // Target namespace of a local element, NULL if not checked
+	int iFlags;
+	int iMinOccurs;
+	int iMaxOccurs; // -1 means unbounded
+
+	const TypeDescriptor* pTypeDescriptor; // Set for complex fields
+	const ValueDescriptor* pValueDescriptor; // Set for simple fields
+
+	FieldCountFunc count;
+	FieldItemFunc item; // May return NULL for an unset pointer member
+	FieldAppendFunc append; // Return the storage to fill during deserialization
+	ValueDeserializeAttributeFunc deserializeAttribute;
+	ValueReadAttributeFunc readAttribute;
+};
+
+typedef const void* (*ConstCastFunc)(const void* pObject);
+typedef void* (*CastFunc)(void* pObject);
+typedef bool (*ObjectIsNullFunc)(const void* pObject);
+typedef void (*ObjectSerializeFunc)(const void* pObject, QByteArray& buffer, bool bOnlyContent);
+typedef void (*ObjectDeserializeFunc)(void* pObject, QDomElement& element);
+typedef void (*ObjectReadFunc)(void* pObject, QXmlStreamReader& reader);
+typedef void (*ObjectReadAttributesFunc)(void* pObject, const QXmlStreamAttributes& attributes);
+typedef bool (*ObjectReadElementFunc)(void* pObject, QXmlStreamReader& reader);
+
+struct TypeDescriptor
+{
+	const char* szName;
+	const char* szNamespace;
+
+	const FieldDescriptor* pFields;
+	int iFieldCount;
+
+	// Extension
+	const TypeDescriptor* pBaseTypeDescriptor;
+	const ValueDescriptor* pBaseValueDescriptor;
+	ConstCastFunc toConstBase;
+	CastFunc toBase;
+
+	ObjectIsNullFunc isNull;
+
+	// Set when the class keeps its own generated serialize/deserialize body
+	ObjectSerializeFunc serialize;
+	ObjectDeserializeFunc deserialize;
+	ObjectReadFunc read;
+	ObjectReadAttributesFunc readAttributes;
+	ObjectReadElementFunc readElement;
+};
+
+class TypeSerializer
+{
+public:
+	static QString serialize(const TypeDescriptor& descriptor, const void* pObject, bool bOnlyContent);
+	// Append the UTF-8 serialization of the object to the buffer
+	static void serialize(const TypeDescriptor& descriptor, const void* pObject, QByteArray& buffer, bool bOnlyContent);
+	static void deserialize(const TypeDescriptor& descriptor, void* pObject, QDomElement& element);
+	// Read the current element of the reader up to its end element
+	static void deserialize(const TypeDescriptor& descriptor, void* pObject, QXmlStreamReader& reader);
+	static void deserializeAttributes(const TypeDescriptor& descriptor, void* pObject, const QXmlStreamAttributes& attributes);
+	// Read the current child element if it matches a field, return false otherwise
+	static bool deserializeElement(const TypeDescriptor& descriptor, void* pObject, QXmlStreamReader& reader);
+
+private:
+	static void appendContent(const TypeDescriptor& descriptor, const void* pObject, QByteArray& buffer);
+	static void appendAttributes(const TypeDescriptor& descriptor, const void* pObject, QByteArray& buffer);
+	static void appendElements(const TypeDescriptor& descriptor, const void* pObject, QByteArray& buffer);
+	static void appendTag(QByteArray& buffer, const char* szPrefix, const char* szNamespace, const char* szName);
+
+	static bool deserializeElement(const TypeDescriptor& descriptor, void* pObject, QXmlStreamReader& reader, quint32 iNameHash);
+
+	static void deserializeContent(const TypeDescriptor& descriptor, void* pObject, QDomElement& element);
+	static const FieldDescriptor* findElementField(const TypeDescriptor& descriptor, const QString& szTagName);
+};
+
+/*
+ * Helpers instantiated by the generated tables
+ */
+
+template<class T>
+struct ValueTraits
+{
+	static QString serialize(const void* pValue)
+	{
+		return static_cast<const T*>(pValue)->serialize();
+	}
+	static void deserialize(void* pValue, const QDomElement& element)
+	{
+		static_cast<T*>(pValue)->deserialize(element);
+	}
+	static void deserializeAttribute(void* pValue, const QDomAttr& attr)
+	{
+		static_cast<T*>(pValue)->deserialize(attr);
+	}
+	static void read(void* pValue, QXmlStreamReader& reader)
+	{
+		static_cast<T*>(pValue)->deserialize(reader);
+	}
+	static void readAttribute(void* pValue, const QXmlStreamAttribute& attr)
+	{
+		static_cast<T*>(pValue)->deserialize(attr);
+	}
+	static bool isNull(const void* pValue)
+	{
+		return static_cast<const T*>(pValue)->isNull();
+	}
+
+	static const ValueDescriptor descriptor;
+};
+
+template<class T>
+const ValueDescriptor ValueTraits<T>::descriptor = {
+	&ValueTraits<T>::serialize,
+	&ValueTraits<T>::deserialize,
+	&ValueTraits<T>::isNull,
+	&ValueTraits<T>::read
+};
+
+template<class T>
+struct TypeTraits
+{
+	static bool isNull(const void* pObject)
+	{
+		return static_cast<const T*>(pObject)->isNull();
+	}
+	static void serialize(const void* pObject, QByteArray& buffer, bool bOnlyContent)
+	{
+		static_cast<const T*>(pObject)->serialize(buffer, bOnlyContent);
+	}
+	static void deserialize(void* pObject, QDomElement& element)
+	{
+		static_cast<T*>(pObject)->deserialize(element);
+	}
+	static void read(void* pObject, QXmlStreamReader& reader)
+	{
+		static_cast<T*>(pObject)->deserialize(reader);
+	}
+	static void readAttributes(void* pObject, const QXmlStreamAttributes& attributes)
+	{
+		static_cast<T*>(pObject)->deserializeAttributes(attributes);
+	}
+	static bool readElement(void* pObject, QXmlStreamReader& reader)
+	{
+		return static_cast<T*>(pObject)->deserializeElement(reader);
+	}
+};
+
+template<class C, class B>
+struct BaseCast
+{
+	static const void* toConstBase(const void* pObject)
+	{
+		return static_cast<const B*>(static_cast<const C*>(pObject));
+	}
+	static void* toBase(void* pObject)
+	{
+		return static_cast<B*>(static_cast<C*>(pObject));
+	}
+};
+
+template<class C, class T, T C::*M>
+struct MemberField
+{
+	static int count(const void*)
+	{
+		return 1;
+	}
+	static const void* item(const void* pObject, int)
+	{
+		return &(static_cast<const C*>(pObject)->*M);
+	}
+	static void* append(void* pObject)
+	{
+		return &(static_cast<C*>(pObject)->*M);
+	}
+};
+
+template<class C, class T, T* C::*M>
+struct PointerField
+{
+	static int count(const void*)
+	{
+		return 1;
+	}
+	static const void* item(const void* pObject, int)
+	{
+		return static_cast<const C*>(pObject)->*M;
+	}
+	static void* append(void* pObject)
+	{
+		C* pClass = static_cast<C*>(pObject);
+		if(!(pClass->*M)){
+			pClass->*M = new T();
+		}
+		return pClass->*M;
+	}
+};
+
+template<class C, class T, QList<T> C::*M>
+struct ListField
+{
+	static int count(const void* pObject)
+	{
+		return (static_cast<const C*>(pObject)->*M).size();
+	}
+	static const void* item(const void* pObject, int iIndex)
+	{
+		return &(static_cast<const C*>(pObject)->*M).at(iIndex);
+	}
+	static void* append(void* pObject)
+	{
+		QList<T>& list = static_cast<C*>(pObject)->*M;
+		list.append(T());
+		return &list.last();
+	}
+};
+
+template<class C, class T, QList<T*> C::*M>
+struct PointerListField
+{
+	static int count(const void* pObject)
+	{
+		return (static_cast<const C*>(pObject)->*M).size();
+	}
+	static const void* item(const void* pObject, int iIndex)
+	{
+		return (static_cast<const C*>(pObject)->*M).at(iIndex);
+	}
+	static void* append(void* pObject)
+	{
+		T* pItem = new T();
+		(static_cast<C*>(pObject)->*M).append(pItem);
+		return pItem;
+	}
+};
+
+}
+
+#endif /* TYPEDESCRIPTOR_H_ */
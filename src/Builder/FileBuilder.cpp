@@ -9,6 +9,8 @@
 #include <functional>
 
 #include <QDir>
+#include <QFileInfo>
+#include <QMap>
 #include <QTextStream>
 
 #include "FileHelper.h"
@@ -118,6 +120,8 @@ public:
 
 			os << "add_library (" << m_szName.toLower() << " ${" << m_szName.toUpper() << "_SRC})" << CRLF << CRLF;
 
+			writeZlibOption(os, m_szName.toLower());
+
 			os << "if(WITH_INSTALL_LIB)" << CRLF;
 			os << "\tinstall(TARGETS " << m_szName.toLower() << " DESTINATION ${INSTALL_PATH_LIB})" << CRLF;
 			os << "endif()" << CRLF << CRLF;
@@ -125,6 +129,228 @@ public:
 	}
 };
 
+class CMakeListsObjectLibrariesFileBuilder : public FileBuilder
+{
+public:
+	CMakeListsObjectLibrariesFileBuilder(const QString& szName, const QString& szDirName, const QSharedPointer<QList<QString> >& pFileList, bool bModules)
+		: FileBuilder(szName, szDirName, pFileList), m_bModules(bModules)
+	{
+
+	}
+
+	virtual ~CMakeListsObjectLibrariesFileBuilder()
+	{
+
+	}
+
+	void generateFile() const
+	{
+		QDir dir(m_szDirName);
+		QFile file(m_szDirName + QDir::separator() + "CMakeLists.txt");
+		if(file.open(QFile::WriteOnly)){
+			// Sources of each namespace directory, ordered by namespace
+			QMap<QString, QList<QString> > mapNamespaceFiles;
+			QList<QString> listServices;
+			QList<QString>::const_iterator iter;
+			for(iter = m_pFileList->constBegin(); iter != m_pFileList->constEnd(); ++iter)
+			{
+				QString szNamespace = FileHelper::getFileNamespace(*iter);
+				if(szNamespace.isEmpty()){
+					listServices.append(*iter);
+				}else{
+					mapNamespaceFiles[szNamespace].append(*iter);
+				}
+			}
+
+			QTextStream os(&file);
+			if(m_bModules){
+				os << "# One C++20 module per schema namespace, requires CMake 3.28" << CRLF << CRLF;
+			}else{
+				os << "# One object library per schema namespace, linking object libraries requires CMake 3.12" << CRLF << CRLF;
+			}
+
+			// Dependencies between namespaces, an edge closing a cycle is dropped
+			// since CMake only allows cyclic dependencies between static libraries
+			QMap<QString, QList<QString> > mapDependencies;
+			QMap<QString, QList<QString> >::const_iterator ns;
+			if(m_pNamespaceDependencyMap){
+				NamespaceDependencyMap mapKeptDependencies;
+				for(ns = mapNamespaceFiles.constBegin(); ns != mapNamespaceFiles.constEnd(); ++ns){
+					QList<QString> listDependencies = m_pNamespaceDependencyMap->value(ns.key());
+					QtCompatSort(listDependencies.begin(), listDependencies.end());
+
+					Q_FOREACH(QString szDependency, listDependencies){
+						if(!mapNamespaceFiles.contains(szDependency)){
+							continue;
+						}
+						if(mapKeptDependencies.dependsOn(szDependency, ns.key())){
+							os << "# " << ns.key() << " -> " << szDependency << " not declared, it closes a cycle" << CRLF;
+							continue;
+						}
+						mapKeptDependencies.addDependency(ns.key(), szDependency);
+						mapDependencies[ns.key()].append(szDependency);
+					}
+				}
+			}
+
+			// Every generated type uses the XS base types
+			if(m_bModules && mapNamespaceFiles.contains("xs")){
+				for(ns = mapNamespaceFiles.constBegin(); ns != mapNamespaceFiles.constEnd(); ++ns){
+					if(ns.key() != "xs" && !mapDependencies.value(ns.key()).contains("xs")){
+						mapDependencies[ns.key()].prepend("xs");
+					}
+				}
+			}
+
+			for(ns = mapNamespaceFiles.constBegin(); ns != mapNamespaceFiles.constEnd(); ++ns){
+				if(m_bModules){
+					QString szModuleFileName = FileHelper::buildModuleFileName(ns.key());
+					generateModuleFile(szModuleFileName, ns.key(), ns.value(), mapDependencies.value(ns.key()));
+
+					// The module interface includes the sources of the namespace
+					os << "add_library (" << getTargetName(ns.key()) << " OBJECT)" << CRLF;
+					os << "target_sources (" << getTargetName(ns.key()) << " PUBLIC FILE_SET CXX_MODULES FILES " << szModuleFileName << ")" << CRLF;
+					os << "target_compile_features (" << getTargetName(ns.key()) << " PUBLIC cxx_std_20)" << CRLF;
+				}else{
+					os << "SET(" << getVariableName(ns.key()) << CRLF;
+					Q_FOREACH(QString szFile, ns.value()){
+						os << "\t" << szFile << CRLF;
+					}
+					os << ")" << CRLF;
+					os << "add_library (" << getTargetName(ns.key()) << " OBJECT ${" << getVariableName(ns.key()) << "})" << CRLF;
+				}
+
+				QList<QString> listDependencies = mapDependencies.value(ns.key());
+				if(!listDependencies.isEmpty()){
+					os << "target_link_libraries (" << getTargetName(ns.key()) << " PUBLIC";
+					Q_FOREACH(QString szDependency, listDependencies){
+						os << " " << getTargetName(szDependency);
+					}
+					os << ")" << CRLF;
+				}
+				os << CRLF;
+			}
+
+			os << "SET(SERVICES_SRC" << CRLF;
+			Q_FOREACH(QString szService, listServices){
+				os << "\t" << szService << CRLF;
+			}
+			os << ")" << CRLF << CRLF;
+
+			if(m_bModules){
+				// Objects of directly linked object libraries are linked in the library
+				os << "add_library (" << m_szName.toLower() << " ${SERVICES_SRC})" << CRLF;
+				os << "target_link_libraries (" << m_szName.toLower() << " PUBLIC";
+				for(ns = mapNamespaceFiles.constBegin(); ns != mapNamespaceFiles.constEnd(); ++ns){
+					os << " " << getTargetName(ns.key());
+				}
+				os << ")" << CRLF << CRLF;
+			}else{
+				os << "SET(" << m_szName.toUpper() << "_SRC" << CRLF;
+				os << "\t" << "${SERVICES_SRC}" << CRLF;
+				for(ns = mapNamespaceFiles.constBegin(); ns != mapNamespaceFiles.constEnd(); ++ns){
+					os << "\t" << "$<TARGET_OBJECTS:" << getTargetName(ns.key()) << ">" << CRLF;
+				}
+				os << ")" << CRLF << CRLF;
+
+				os << "add_library (" << m_szName.toLower() << " ${" << m_szName.toUpper() << "_SRC})" << CRLF << CRLF;
+			}
+
+			writeZlibOption(os, m_szName.toLower());
+
+			os << "if(WITH_INSTALL_LIB)" << CRLF;
+			os << "\tinstall(TARGETS " << m_szName.toLower() << " DESTINATION ${INSTALL_PATH_LIB})" << CRLF;
+			os << "endif()" << CRLF << CRLF;
+		}
+	}
+
+private:
+	QString getTargetName(const QString& szNamespace) const
+	{
+		return m_szName.toLower() + "_" + szNamespace;
+	}
+
+	QString getVariableName(const QString& szNamespace) const
+	{
+		QString szVariableName = szNamespace.toUpper();
+		for(int i = 0; i < szVariableName.size(); ++i){
+			if(!szVariableName[i].isLetterOrNumber()){
+				szVariableName[i] = '_';
+			}
+		}
+		return szVariableName + "_SRC";
+	}
+
+	void generateModuleFile(const QString& szModuleFileName, const QString& szNamespace, const QList<QString>& listFiles, const QList<QString>& listDependencies) const
+	{
+		QFile file(QDir(m_szDirName).filePath(szModuleFileName));
+		if(!file.open(QFile::WriteOnly)){
+			qWarning("[FileBuilder] Cannot open file %s (error: %s)", qPrintable(szModuleFileName), qPrintable(file.errorString()));
+			return;
+		}
+
+		QTextStream os(&file);
+		os << "/*" << CRLF;
+		os << " * " << QFileInfo(szModuleFileName).fileName() << CRLF;
+		os << " * " << CRLF;
+		os << " * Module interface of the " << szNamespace << " namespace, the generated files of" << CRLF;
+		os << " * the namespace are included in its purview." << CRLF;
+		os << " * License: MIT License" << CRLF;
+		os << " */" << CRLF;
+		os << CRLF;
+
+		// Headers used by the generated files are parsed in the global module fragment
+		os << "module;" << CRLF;
+		os << CRLF;
+		os << "#include <QtCore>" << CRLF;
+		os << "#include <QtXml>" << CRLF;
+		if(m_pFileList->contains("NameHash.h")){
+			os << "#include \"../NameHash.h\"" << CRLF;
+		}
+		if(m_pFileList->contains("ObjectArena.h")){
+			os << "#include \"../ObjectArena.h\"" << CRLF;
+		}
+		if(m_pFileList->contains("TypeDescriptor.h")){
+			os << "#include \"../TypeDescriptor.h\"" << CRLF;
+		}
+		os << CRLF;
+
+		os << "export module " << FileHelper::buildModuleName(m_szName, szNamespace) << ";" << CRLF;
+		os << CRLF;
+
+		if(!listDependencies.isEmpty()){
+			Q_FOREACH(QString szDependency, listDependencies){
+				os << "export import " << FileHelper::buildModuleName(m_szName, szDependency) << ";" << CRLF;
+			}
+			os << CRLF;
+		}
+
+		os << "#define " << FileHelper::buildModulePurviewDefine(m_szName) << CRLF;
+		os << CRLF;
+
+		// Files are referenced from the directory of the namespace
+		int iPrefixLength = szNamespace.length() + 1;
+
+		os << "export {" << CRLF;
+		Q_FOREACH(QString szFile, listFiles){
+			if(szFile.endsWith(".h")){
+				os << "#include \"" << szFile.mid(iPrefixLength) << "\"" << CRLF;
+			}
+		}
+		os << "}" << CRLF;
+		os << CRLF;
+
+		Q_FOREACH(QString szFile, listFiles){
+			if(szFile.endsWith(".cpp")){
+				os << "#include \"" << szFile.mid(iPrefixLength) << "\"" << CRLF;
+			}
+		}
+	}
+
+private:
+	bool m_bModules;
+};
+
 FileBuilder::FileBuilder(const QString& szName, const QString& szDirName, const QSharedPointer<QList<QString> >& pFileList)
 	: m_szName(szName), m_szDirName(szDirName), m_pFileList(pFileList)
 {
@@ -136,11 +362,36 @@ FileBuilder::~FileBuilder()
 
 }
 
+void FileBuilder::writeZlibOption(QTextStream& os, const QString& szTargetName) const
+{
+	// Used by Service.cpp and ResponseInflater.cpp to compress the requests and decode the responses
+	if(!m_pFileList->contains("Service.cpp")){
+		return;
+	}
+
+	os << "find_package (ZLIB QUIET)" << CRLF;
+	os << "option(SOAPERO_WITH_ZLIB \"Enable build with zlib library\" ${ZLIB_FOUND})" << CRLF;
+	os << "if(SOAPERO_WITH_ZLIB)" << CRLF;
+	os << "\tfind_package (ZLIB REQUIRED)" << CRLF;
+	os << "\ttarget_compile_definitions (" << szTargetName << " PUBLIC SOAPERO_WITH_ZLIB)" << CRLF;
+	os << "\ttarget_link_libraries (" << szTargetName << " PUBLIC ZLIB::ZLIB)" << CRLF;
+	os << "endif()" << CRLF << CRLF;
+}
+
+void FileBuilder::setNamespaceDependencyMap(const NamespaceDependencyMapSharedPtr& pNamespaceDependencyMap)
+{
+	m_pNamespaceDependencyMap = pNamespaceDependencyMap;
+}
+
 FileBuilder* FileBuilder::createFileBuilderFromType(FileType fileType, const QString& szName, const QString& szDirName, const QSharedPointer<QList<QString> >& pFileList)
 {
 	switch(fileType){
 	case CMakeLists:
 		return new CMakeListsFileBuilder(szName, szDirName, pFileList);
+	case CMakeListsObjectLibraries:
+		return new CMakeListsObjectLibrariesFileBuilder(szName, szDirName, pFileList, false);
+	case CMakeListsModules:
+		return new CMakeListsObjectLibrariesFileBuilder(szName, szDirName, pFileList, true);
 	default:
 		return new DefaultFileBuilder(szName, szDirName, pFileList);
 	}
@@ -11,12 +11,17 @@
 #include <QList>
 #include <QSharedPointer>
 #include <QString>
+#include <QTextStream>
+
+#include "Utils/NamespaceDependencyMap.h"
 
 class FileBuilder {
 public:
 	enum FileType {
 		Default,
-		CMakeLists
+		CMakeLists,
+		CMakeListsObjectLibraries,
+		CMakeListsModules
 	};
 
 protected:
@@ -27,12 +32,19 @@ public:
 
 	virtual ~FileBuilder();
 
+	void setNamespaceDependencyMap(const NamespaceDependencyMapSharedPtr& pNamespaceDependencyMap);
+
 	virtual void generateFile() const = 0;
 
+protected:
+	// Option building the service with zlib, on by default when zlib is found
+	void writeZlibOption(QTextStream& os, const QString& szTargetName) const;
+
 protected:
 	QString m_szName;
 	QString m_szDirName;
 	QSharedPointer<QList<QString> > m_pFileList;
+	NamespaceDependencyMapSharedPtr m_pNamespaceDependencyMap;
 };
 
 #endif /* SRC_BUILDER_FILEBUILDER_H_ */
@@ -4,6 +4,8 @@
 
 #include <QDir>
 
+#include "../Utils/StringUtils.h"
+
 #include "FileHelper.h"
 
 FileHelper::FileHelper()
@@ -34,6 +36,37 @@ bool FileHelper::isFileMessage(const QString& szFilePath)
 #endif
 }
 
+QString FileHelper::getFileNamespace(const QString& szFilePath)
+{
+#ifdef WITH_DIR_CREATION
+	int iIndex = szFilePath.indexOf("/types/");
+	if(iIndex < 0){
+		iIndex = szFilePath.indexOf("/messages/");
+	}
+	if(iIndex > 0){
+		return szFilePath.left(iIndex).section('/', -1);
+	}
+#else
+	Q_UNUSED(szFilePath);
+#endif
+	return QString();
+}
+
+QString FileHelper::buildModuleName(const QString& szNamespace, const QString& szFileNamespace)
+{
+	return StringUtils::secureString(szNamespace.toLower()) + "." + StringUtils::secureString(szFileNamespace.toLower());
+}
+
+QString FileHelper::buildModuleFileName(const QString& szFileNamespace)
+{
+	return buildPath(QString(), szFileNamespace, QString(), buildFileName(szFileNamespace, "module", "cppm"));
+}
+
+QString FileHelper::buildModulePurviewDefine(const QString& szNamespace)
+{
+	return StringUtils::secureString(szNamespace.toUpper()) + "_MODULE_PURVIEW";
+}
+
 QString FileHelper::buildPath(const QString& szBaseDirectory, const QString& szFileNamespace, const QString& szFileCategory, const QString& szFileName)
 {
 	QDir dir;
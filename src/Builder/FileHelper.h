@@ -22,6 +22,14 @@ public:
 
 	static bool isFileTypes(const QString& szFilePath);
 	static bool isFileMessage(const QString& szFilePath);
+
+	// Return the namespace directory of a generated types or messages file
+	static QString getFileNamespace(const QString& szFilePath);
+
+	// Naming of the C++20 module generated for a namespace directory
+	static QString buildModuleName(const QString& szNamespace, const QString& szFileNamespace);
+	static QString buildModuleFileName(const QString& szFileNamespace);
+	static QString buildModulePurviewDefine(const QString& szNamespace);
 };
 
 
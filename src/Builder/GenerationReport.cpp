@@ -0,0 +1,239 @@
+/*
+ * GenerationReport.cpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#include <QDir>
+#include <QFile>
+
+#include "GenerationReport.h"
+
+#ifndef CRLF
+#define CRLF "\r\n"
+#endif
+
+GenerationReport::GenerationReport()
+{
+
+}
+
+GenerationReport::~GenerationReport()
+{
+
+}
+
+GenerationReportSharedPtr GenerationReport::create()
+{
+	return GenerationReportSharedPtr(new GenerationReport());
+}
+
+void GenerationReport::addEntry(const QString& szHeaderFile, const QString& szCppFile, const QString& szName, const QString& szCategory)
+{
+	Entry& entry = m_mapEntries[szHeaderFile];
+	entry.szName = szName;
+	entry.szCategory = szCategory;
+	entry.szCppFile = szCppFile;
+	entry.iListMemberCount = 0;
+	entry.iLineCount = 0;
+	entry.iIncludeDepth = 0;
+	entry.iDependentCount = 0;
+}
+
+void GenerationReport::addDependency(const QString& szHeaderFile, const QString& szDependencyHeaderFile)
+{
+	QMap<QString, Entry>::iterator iter = m_mapEntries.find(szHeaderFile);
+	if(iter != m_mapEntries.end() && !szDependencyHeaderFile.isEmpty() && szDependencyHeaderFile != szHeaderFile){
+		iter.value().listDependencies.append(szDependencyHeaderFile);
+	}
+}
+
+void GenerationReport::setListMemberCount(const QString& szHeaderFile, int iListMemberCount)
+{
+	QMap<QString, Entry>::iterator iter = m_mapEntries.find(szHeaderFile);
+	if(iter != m_mapEntries.end()){
+		iter.value().iListMemberCount = iListMemberCount;
+	}
+}
+
+void GenerationReport::markPointer(const QString& szHeaderFile)
+{
+	m_listPointerHeaders.append(szHeaderFile);
+}
+
+void GenerationReport::markNested(const QString& szHeaderFile)
+{
+	m_listNestedHeaders.append(szHeaderFile);
+}
+
+bool GenerationReport::generateFile(const QString& szDirName, const QString& szFilePath, Format iFormat) const
+{
+	QMap<QString, Entry> mapEntries = m_mapEntries;
+	QMap<QString, Entry>::iterator iter;
+	QMap<QString, Entry>::const_iterator entry;
+
+	// Reverse include graph
+	QMap<QString, UniqueStringList> mapDependents;
+	for(entry = m_mapEntries.constBegin(); entry != m_mapEntries.constEnd(); ++entry){
+		UniqueStringList::const_iterator dependency;
+		for(dependency = entry.value().listDependencies.constBegin(); dependency != entry.value().listDependencies.constEnd(); ++dependency){
+			mapDependents[*dependency].append(entry.key());
+		}
+	}
+
+	QMap<QString, int> mapDepths;
+	QSet<QString> setChain;
+	bool bInCycle;
+	QMultiMap<int, QString> mapSortedHeaders;
+	for(iter = mapEntries.begin(); iter != mapEntries.end(); ++iter){
+		Entry& current = iter.value();
+		current.iLineCount = getLineCount(QDir(szDirName).filePath(iter.key())) + getLineCount(QDir(szDirName).filePath(current.szCppFile));
+		current.iIncludeDepth = getIncludeDepth(iter.key(), mapDepths, setChain, bInCycle);
+		current.iDependentCount = getDependentCount(iter.key(), mapDependents);
+		mapSortedHeaders.insert(-current.iLineCount, iter.key());
+	}
+
+	QFile file(szFilePath);
+	if(!file.open(QFile::WriteOnly)){
+		qWarning("[GenerationReport] Cannot open file %s (error: %s)", qPrintable(szFilePath), qPrintable(file.errorString()));
+		return false;
+	}
+
+	QTextStream os(&file);
+	if(iFormat == Format_CSV){
+		writeCSV(os, mapSortedHeaders.values(), mapEntries);
+	}else{
+		writeJSON(os, mapSortedHeaders.values(), mapEntries);
+	}
+	return true;
+}
+
+int GenerationReport::getLineCount(const QString& szFilePath)
+{
+	int iLineCount = 0;
+	QFile file(szFilePath);
+	if(!szFilePath.isEmpty() && file.open(QFile::ReadOnly)){
+		QByteArray bytes = file.readAll();
+		iLineCount = bytes.count('\n');
+		if(!bytes.isEmpty() && !bytes.endsWith('\n')){
+			iLineCount++;
+		}
+	}
+	return iLineCount;
+}
+
+int GenerationReport::getIncludeDepth(const QString& szHeaderFile, QMap<QString, int>& mapDepths, QSet<QString>& setChain, bool& bInCycle) const
+{
+	bInCycle = false;
+
+	QMap<QString, int>::const_iterator depth = mapDepths.constFind(szHeaderFile);
+	if(depth != mapDepths.constEnd()){
+		return depth.value();
+	}
+
+	if(setChain.contains(szHeaderFile)){
+		bInCycle = true;
+		return 0;
+	}
+
+	QMap<QString, Entry>::const_iterator entry = m_mapEntries.constFind(szHeaderFile);
+	if(entry == m_mapEntries.constEnd()){
+		// Header not generated from the schema (base types)
+		return 0;
+	}
+
+	setChain.insert(szHeaderFile);
+
+	int iDepth = 0;
+	int iDependencyDepth;
+	bool bDependencyInCycle;
+	bool bDependsOnChain = false;
+	UniqueStringList::const_iterator dependency;
+	for(dependency = entry.value().listDependencies.constBegin(); dependency != entry.value().listDependencies.constEnd(); ++dependency){
+		iDependencyDepth = getIncludeDepth(*dependency, mapDepths, setChain, bDependencyInCycle) + 1;
+		if(bDependencyInCycle){
+			bDependsOnChain = true;
+		}
+		if(iDependencyDepth > iDepth){
+			iDepth = iDependencyDepth;
+		}
+	}
+
+	setChain.remove(szHeaderFile);
+
+	// A depth computed with a cycle cut depends on the chain it was reached from
+	if(bDependsOnChain){
+		bInCycle = true;
+	}else{
+		mapDepths.insert(szHeaderFile, iDepth);
+	}
+	return iDepth;
+}
+
+int GenerationReport::getDependentCount(const QString& szHeaderFile, const QMap<QString, UniqueStringList>& mapDependents) const
+{
+	UniqueStringList listVisited;
+	QList<QString> listPending;
+	listPending.append(szHeaderFile);
+
+	while(!listPending.isEmpty()){
+		QString szCurrent = listPending.takeFirst();
+		UniqueStringList listDependents = mapDependents.value(szCurrent);
+		UniqueStringList::const_iterator dependent;
+		for(dependent = listDependents.constBegin(); dependent != listDependents.constEnd(); ++dependent){
+			if(*dependent != szHeaderFile && !listVisited.contains(*dependent)){
+				listVisited.append(*dependent);
+				listPending.append(*dependent);
+			}
+		}
+	}
+
+	return listVisited.size();
+}
+
+void GenerationReport::writeJSON(QTextStream& os, const QList<QString>& listHeaderFiles, const QMap<QString, Entry>& mapEntries) const
+{
+	os << "[" << CRLF;
+	QList<QString>::const_iterator iter;
+	for(iter = listHeaderFiles.constBegin(); iter != listHeaderFiles.constEnd(); ++iter){
+		const Entry& entry = mapEntries[*iter];
+		os << "\t{";
+		os << "\"name\": \"" << escapeJSON(entry.szName) << "\", ";
+		os << "\"category\": \"" << entry.szCategory << "\", ";
+		os << "\"header\": \"" << escapeJSON(*iter) << "\", ";
+		os << "\"lines\": " << entry.iLineCount << ", ";
+		os << "\"includeDepth\": " << entry.iIncludeDepth << ", ";
+		os << "\"dependents\": " << entry.iDependentCount << ", ";
+		os << "\"listMembers\": " << entry.iListMemberCount << ", ";
+		os << "\"pointer\": " << (m_listPointerHeaders.contains(*iter) ? "true" : "false") << ", ";
+		os << "\"nested\": " << (m_listNestedHeaders.contains(*iter) ? "true" : "false");
+		os << "}" << ((iter + 1) != listHeaderFiles.constEnd() ? "," : "") << CRLF;
+	}
+	os << "]" << CRLF;
+}
+
+void GenerationReport::writeCSV(QTextStream& os, const QList<QString>& listHeaderFiles, const QMap<QString, Entry>& mapEntries) const
+{
+	os << "name,category,header,lines,include_depth,dependents,list_members,pointer,nested" << CRLF;
+	QList<QString>::const_iterator iter;
+	for(iter = listHeaderFiles.constBegin(); iter != listHeaderFiles.constEnd(); ++iter){
+		const Entry& entry = mapEntries[*iter];
+		os << entry.szName << ",";
+		os << entry.szCategory << ",";
+		os << *iter << ",";
+		os << entry.iLineCount << ",";
+		os << entry.iIncludeDepth << ",";
+		os << entry.iDependentCount << ",";
+		os << entry.iListMemberCount << ",";
+		os << (m_listPointerHeaders.contains(*iter) ? "1" : "0") << ",";
+		os << (m_listNestedHeaders.contains(*iter) ? "1" : "0") << CRLF;
+	}
+}
+
+QString GenerationReport::escapeJSON(const QString& szValue)
+{
+	QString szRet = szValue;
+	szRet.replace("\\", "\\\\");
+	szRet.replace("\"", "\\\"");
+	return szRet;
+}
@@ -0,0 +1,79 @@
+/*
+ * GenerationReport.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef SRC_BUILDER_GENERATIONREPORT_H_
+#define SRC_BUILDER_GENERATIONREPORT_H_
+
+#include <QMap>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+#include <QTextStream>
+
+#include "Utils/UniqueStringList.h"
+
+class GenerationReport;
+typedef QSharedPointer<GenerationReport> GenerationReportSharedPtr;
+
+/*
+ * Size and compile cost of each generated type or message. Entries are
+ * identified by the path of their header relative to the output directory.
+ */
+class GenerationReport
+{
+public:
+	enum Format {
+		Format_JSON,
+		Format_CSV
+	};
+
+public:
+	GenerationReport();
+	virtual ~GenerationReport();
+
+	static GenerationReportSharedPtr create();
+
+	void addEntry(const QString& szHeaderFile, const QString& szCppFile, const QString& szName, const QString& szCategory);
+	void addDependency(const QString& szHeaderFile, const QString& szDependencyHeaderFile);
+	void setListMemberCount(const QString& szHeaderFile, int iListMemberCount);
+	void markPointer(const QString& szHeaderFile);
+	void markNested(const QString& szHeaderFile);
+
+	// Write the report, entries are sorted by decreasing generated lines of code
+	bool generateFile(const QString& szDirName, const QString& szFilePath, Format iFormat) const;
+
+private:
+	struct Entry
+	{
+		QString szName;
+		QString szCategory;
+		QString szCppFile;
+		UniqueStringList listDependencies;
+		int iListMemberCount;
+
+		// Computed when generating the report
+		int iLineCount;
+		int iIncludeDepth;
+		int iDependentCount;
+	};
+
+	static int getLineCount(const QString& szFilePath);
+	// Longest include chain from the header, an include back to a header of the current chain
+	// (cycle broken by forward declarations) is not followed. Only the depths which do not
+	// depend on the current chain are memoized, bInCycle is set for the others.
+	int getIncludeDepth(const QString& szHeaderFile, QMap<QString, int>& mapDepths, QSet<QString>& setChain, bool& bInCycle) const;
+	int getDependentCount(const QString& szHeaderFile, const QMap<QString, UniqueStringList>& mapDependents) const;
+
+	void writeJSON(QTextStream& os, const QList<QString>& listHeaderFiles, const QMap<QString, Entry>& mapEntries) const;
+	void writeCSV(QTextStream& os, const QList<QString>& listHeaderFiles, const QMap<QString, Entry>& mapEntries) const;
+	static QString escapeJSON(const QString& szValue);
+
+	QMap<QString, Entry> m_mapEntries;
+	UniqueStringList m_listPointerHeaders;
+	UniqueStringList m_listNestedHeaders;
+};
+
+#endif /* SRC_BUILDER_GENERATIONREPORT_H_ */
@@ -11,6 +11,7 @@
 #include <QDir>
 
 #include "../Utils/StringUtils.h"
+#include "../Utils/CodeWriter.h"
 #include "TypeListBuilder.h"
 #include "FileHelper.h"
 
@@ -27,6 +28,9 @@ TypeListBuilder::TypeListBuilder(const ServiceSharedPtr& pService, const TypeLis
 	m_pListGeneratedFiles = pListGeneratedFiles;
 
 	m_szPrefix = "";
+
+	m_iSerializationMode = SerializationMode_Default;
+	m_bModuleOutput = false;
 }
 
 TypeListBuilder::~TypeListBuilder()
@@ -74,6 +78,56 @@ QString TypeListBuilder::getDirname() const
 	return m_szDirname;
 }
 
+void TypeListBuilder::setSerializationMode(SerializationMode iSerializationMode)
+{
+	m_iSerializationMode = iSerializationMode;
+}
+
+TypeListBuilder::SerializationMode TypeListBuilder::getSerializationMode() const
+{
+	return m_iSerializationMode;
+}
+
+void TypeListBuilder::setNamespaceDependencyMap(const NamespaceDependencyMapSharedPtr& pNamespaceDependencyMap)
+{
+	m_pNamespaceDependencyMap = pNamespaceDependencyMap;
+}
+
+NamespaceDependencyMapSharedPtr TypeListBuilder::getNamespaceDependencyMap() const
+{
+	return m_pNamespaceDependencyMap;
+}
+
+void TypeListBuilder::setGenerationReport(const GenerationReportSharedPtr& pGenerationReport)
+{
+	m_pGenerationReport = pGenerationReport;
+}
+
+GenerationReportSharedPtr TypeListBuilder::getGenerationReport() const
+{
+	return m_pGenerationReport;
+}
+
+void TypeListBuilder::setModuleOutput(bool bModuleOutput)
+{
+	m_bModuleOutput = bModuleOutput;
+}
+
+bool TypeListBuilder::isModuleOutput() const
+{
+	return m_bModuleOutput;
+}
+
+void TypeListBuilder::setOperationCacheTtlMap(const QMap<QString, int>& mapOperationCacheTtl)
+{
+	m_mapOperationCacheTtl = mapOperationCacheTtl;
+}
+
+QMap<QString, int> TypeListBuilder::getOperationCacheTtlMap() const
+{
+	return m_mapOperationCacheTtl;
+}
+
 QString TypeListBuilder::getHeaderPath(const QString& szNamespace, const QString& szCategory, const QString& szFilename, FileCategory iOrigin)
 {
 	QString szRootPath;
@@ -346,6 +400,9 @@ void TypeListBuilder::buildHeaderFile(const TypeSharedPtr& pType)
 		buildHeaderFileDescription(os, szHeaderFilename, szDefine);
 
 		buildHeaderIncludeType(os, pType);
+		addNamespaceDependencies(pType->getNamespace(), pType);
+		addReportEntry(szShortFilePath, FileHelper::buildPath(QString(), pType->getNamespace(), "types", getCppFileName(pType)),
+				pType->getQualifiedName(), "type", pType, false);
 
 		os << CRLF;
 
@@ -390,6 +447,10 @@ void TypeListBuilder::buildHeaderFile(const RequestResponseElementSharedPtr& pEl
 		buildHeaderFileDescription(os, szHeaderFilename, szDefine);
 
 		buildHeaderIncludeElement(os, pElement);
+		addNamespaceDependency(pElement->getNamespace(), pElement->getType());
+		addNamespaceDependencies(pElement->getNamespace(), pElement->getType());
+		addReportEntry(szShortFilePath, FileHelper::buildPath(QString(), pElement->getNamespace(), "messages", getCppFileName(pElement)),
+				pElement->getQualifiedName(), "message", pElement->getType(), true);
 
 		os << CRLF;
 
@@ -574,6 +635,7 @@ void TypeListBuilder::buildCppFile(const ServiceSharedPtr& pService)
 		os << "#include <QNetworkRequest>" << CRLF;
 		os << "#include <QNetworkReply>" << CRLF;
 		os << "#include <QStringList>" << CRLF;
+		os << "#include <QXmlStreamReader>" << CRLF;
 		os << CRLF;
 		os << "#include \"" << szHeaderFilename << "\"" << CRLF;
 		os << CRLF;
@@ -620,8 +682,8 @@ void TypeListBuilder::buildHeaderClassType(QTextStream& os, const TypeSharedPtr&
 	if(pType->getTypeMode() == Type::TypeSimple) {
 		SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pType);
 
-		os << "const QString " << pSimpleType->getLocalName(true) << "TargetNamespace = \"" << pSimpleType->getNamespace() << "\";" CRLF;
-		os << "const QString " << pSimpleType->getLocalName(true) << "TargetNamespaceUri = \"" << pSimpleType->getNamespaceUri() << "\";" CRLF;
+		os << getConstantQualifier() << "QString " << pSimpleType->getLocalName(true) << "TargetNamespace = \"" << pSimpleType->getNamespace() << "\";" CRLF;
+		os << getConstantQualifier() << "QString " << pSimpleType->getLocalName(true) << "TargetNamespaceUri = \"" << pSimpleType->getNamespaceUri() << "\";" CRLF;
 		os << CRLF;
 
 		os << "class " << szClassname << CRLF;
@@ -645,8 +707,8 @@ void TypeListBuilder::buildHeaderClassType(QTextStream& os, const TypeSharedPtr&
 	} else if(pType->getTypeMode() == Type::TypeComplex) {
 		ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(pType);
 
-		os << "const QString " << pComplexType->getLocalName(true) << "TargetNamespace = \"" << pComplexType->getNamespace() << "\";" CRLF;
-		os << "const QString " << pComplexType->getLocalName(true) << "TargetNamespaceUri = \"" << pComplexType->getNamespaceUri() << "\";" CRLF;
+		os << getConstantQualifier() << "QString " << pComplexType->getLocalName(true) << "TargetNamespace = \"" << pComplexType->getNamespace() << "\";" CRLF;
+		os << getConstantQualifier() << "QString " << pComplexType->getLocalName(true) << "TargetNamespaceUri = \"" << pComplexType->getNamespaceUri() << "\";" CRLF;
 		os << CRLF;
 
 		if(pComplexType->getElementList()){
@@ -733,15 +795,33 @@ void TypeListBuilder::buildHeaderClassComplexType(QTextStream& os, const Complex
 	}
 
 	os << "\t" << pComplexType->getSerializerDeclaration() << CRLF;
+	os << "\t" << pComplexType->getBufferSerializerDeclaration() << CRLF;
 	os << "\t" << pComplexType->getDeserializerDeclaration() << CRLF;
 	os << CRLF;
 	os << "\t" << pComplexType->getIsNullDeclaration() << CRLF;
 	os << CRLF;
 	os << "\t" << pComplexType->getGetNamespaceDeclarationDeclaration() << CRLF;
 	os << CRLF;
+	os << "\t" << pComplexType->getArenaOperatorsDeclaration() << CRLF;
+	os << CRLF;
+
+	if(m_iSerializationMode == SerializationMode_Table) {
+		os << "\t" << pComplexType->getTypeDescriptorDeclaration() << CRLF;
+		os << CRLF;
+	}
 
 	if(pListAttributes->count() > 0 || pListElements->count() > 0) {
 		os << "private:" << CRLF;
+		if(m_iSerializationMode == SerializationMode_Table) {
+			QString szFieldDescriptorDeclaration = pComplexType->getFieldDescriptorDeclaration();
+			if(!szFieldDescriptorDeclaration.isEmpty()) {
+				os << "\t" << szFieldDescriptorDeclaration << CRLF;
+				os << CRLF;
+			}
+		}
+
+		CodeWriter writer;
+		writer.setIndentLevel(1);
 		for(attr = pListAttributes->constBegin(); attr != pListAttributes->constEnd(); ++attr) {
 			if((*attr)->hasRef()){
 				pAttribute = (*attr)->getRef();
@@ -753,7 +833,7 @@ void TypeListBuilder::buildHeaderClassComplexType(QTextStream& os, const Complex
 				continue;
 			}
 
-			os << "\t" << pAttribute->getVariableDeclaration() << CRLF;
+			pAttribute->writeVariableDeclaration(writer);
 		}
 		for(element = pListElements->constBegin(); element != pListElements->constEnd(); ++element) {
 			if((*element)->hasRef()){
@@ -766,8 +846,9 @@ void TypeListBuilder::buildHeaderClassComplexType(QTextStream& os, const Complex
 				continue;
 			}
 
-			os << "\t" << pElement->getVariableDeclaration() << CRLF ;
+			pElement->writeVariableDeclaration(writer);
 		}
+		writer.flush(os);
 	}
 }
 
@@ -791,8 +872,8 @@ void TypeListBuilder::buildHeaderClassElement(QTextStream& os, const RequestResp
 	if(!pComplexType.isNull())
 	{
 		// Write namespace
-		os << "const QString " << szClassName << "TargetNamespace = \"" << pElement->getNamespace() << "\";" CRLF;
-		os << "const QString " << szClassName << "TargetNamespaceUri = \"" << pElement->getNamespaceUri() << "\";" CRLF;
+		os << getConstantQualifier() << "QString " << szClassName << "TargetNamespace = \"" << pElement->getNamespace() << "\";" CRLF;
+		os << getConstantQualifier() << "QString " << szClassName << "TargetNamespaceUri = \"" << pElement->getNamespaceUri() << "\";" CRLF;
 		os << CRLF;
 
 		startCppClass(os, szClassName, pComplexType);
@@ -825,11 +906,22 @@ void TypeListBuilder::buildHeaderClassService(QTextStream& os, const ServiceShar
 			continue;
 		}
 		os << "\t" << (*operation)->getOperationDeclaration() << CRLF;
+		os << "\t" << (*operation)->getAsyncOperationDeclaration() << CRLF;
+		os << "\t" << (*operation)->getBatchOperationDeclaration() << CRLF;
 	}
 
 	os << CRLF;
 	os << "\tQMap<QString, QString> buildNamespaceRoutingMap(const QDomDocument& doc) const;" << CRLF;
 
+	os << CRLF;
+	os << "protected:" << CRLF;
+	for(operation = pOperationList->constBegin(); operation != pOperationList->constEnd(); ++operation) {
+		if(!(*operation)->getInputMessage()) {
+			continue;
+		}
+		os << "\t" << (*operation)->getPrepareQueryDeclaration() << CRLF;
+	}
+
 	os << CRLF;
 	os << "public:" << CRLF;
 	os << "\tvoid setDebug(bool bDebug);" << CRLF;
@@ -842,15 +934,17 @@ void TypeListBuilder::buildHeaderClassService(QTextStream& os, const ServiceShar
 
 void TypeListBuilder::buildHeaderIncludeType(QTextStream& os, const TypeSharedPtr& pType) const
 {
+	os << "#include <QByteArray>" << CRLF;
 	os << "#include <QDomElement>" << CRLF;
 	os << "#include <QList>" << CRLF;
 	os << "#include <QString>" << CRLF;
+	os << "#include <QXmlStreamReader>" << CRLF;
 	os << CRLF;
 
 	if(pType->getTypeMode() == Type::TypeSimple) {
 		SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pType);
 		if(pSimpleType->hasVariableType()) {
-			os << "#include \"" << getSimpleTypeHeaderPath(pSimpleType, FileCategory_Type) << "\"" << CRLF;
+			buildInclude(os, pType->getNamespace(), getSimpleTypeHeaderPath(pSimpleType, FileCategory_Type));
 		}
 	}else if(pType->getTypeMode() == Type::TypeComplex){
 
@@ -864,8 +958,14 @@ void TypeListBuilder::buildHeaderIncludeType(QTextStream& os, const TypeSharedPt
 		ElementList::const_iterator element;
 		ElementSharedPtr pElement;
 
+		os << "#include \"" << getHeaderPath(QString(), QString(), "NameHash.h", FileCategory_Type) << "\"" << CRLF;
+		os << "#include \"" << getHeaderPath(QString(), QString(), "ObjectArena.h", FileCategory_Type) << "\"" << CRLF;
+		if(m_iSerializationMode == SerializationMode_Table) {
+			os << "#include \"" << getHeaderPath(QString(), QString(), "TypeDescriptor.h", FileCategory_Type) << "\"" << CRLF;
+		}
+
 		if(!pComplexType->getExtensionType().isNull()) {
-			os << "#include \"" << getTypeHeaderPath(pComplexType->getExtensionType(), FileCategory_Type) << "\"" << CRLF;
+			buildInclude(os, pType->getNamespace(), getTypeHeaderPath(pComplexType->getExtensionType(), FileCategory_Type));
 		}
 
 		if(pListAttributes->count() > 0 || pListElements->count() > 0) {
@@ -886,7 +986,7 @@ void TypeListBuilder::buildHeaderIncludeType(QTextStream& os, const TypeSharedPt
 				// Add required include file
 				QString szFilename = getTypeHeaderPath(pAttribute->getType(), FileCategory_Type);
 				if(!list.contains(szFilename)) {
-					os << "#include \"" << szFilename << "\"" << CRLF;
+					buildInclude(os, pType->getNamespace(), szFilename);
 					list.append(szFilename);
 				}
 			}
@@ -909,7 +1009,7 @@ void TypeListBuilder::buildHeaderIncludeType(QTextStream& os, const TypeSharedPt
 				// Add required include file
 				QString szFilename = getTypeHeaderPath(pElement->getType(), FileCategory_Type);
 				if(!szFilename.isEmpty() && !list.contains(szFilename)) {
-					os << "#include \"" << szFilename << "\"" << CRLF;
+					buildInclude(os, pType->getNamespace(), szFilename);
 					list.append(szFilename);
 				}
 			}
@@ -926,9 +1026,11 @@ void TypeListBuilder::buildHeaderIncludeElement(QTextStream& os, const RequestRe
 		pComplexType = qSharedPointerCast<ComplexType>(pType);
 	}
 
+	os << "#include <QByteArray>" << CRLF;
 	os << "#include <QDomElement>" << CRLF;
 	os << "#include <QList>" << CRLF;
 	os << "#include <QString>" << CRLF;
+	os << "#include <QXmlStreamReader>" << CRLF;
 	os << CRLF;
 
 	AttributeListSharedPtr pListAttributes;
@@ -943,8 +1045,14 @@ void TypeListBuilder::buildHeaderIncludeElement(QTextStream& os, const RequestRe
 		pListAttributes = pComplexType->getAttributeList();
 		pListElements = pComplexType->getElementList();
 
+		os << "#include \"" << getHeaderPath(QString(), QString(), "NameHash.h", FileCategory_Message) << "\"" << CRLF;
+		os << "#include \"" << getHeaderPath(QString(), QString(), "ObjectArena.h", FileCategory_Message) << "\"" << CRLF;
+		if(m_iSerializationMode == SerializationMode_Table) {
+			os << "#include \"" << getHeaderPath(QString(), QString(), "TypeDescriptor.h", FileCategory_Message) << "\"" << CRLF;
+		}
+
 		if(!pComplexType->getExtensionType().isNull()) {
-			os << "#include \"" << getTypeHeaderPath(pComplexType->getExtensionType(), FileCategory_Type) << "\"" << CRLF;
+			buildInclude(os, pRequestResponseElement->getNamespace(), getTypeHeaderPath(pComplexType->getExtensionType(), FileCategory_Type));
 			os << CRLF;
 		}
 	}
@@ -967,7 +1075,7 @@ void TypeListBuilder::buildHeaderIncludeElement(QTextStream& os, const RequestRe
 			// Add required include file
 			QString szFilename = getTypeHeaderPath(pAttribute->getType(), FileCategory_Type);
 			if(!list.contains(szFilename)) {
-				os << "#include \"" << szFilename << "\"" << CRLF;
+				buildInclude(os, pRequestResponseElement->getNamespace(), szFilename);
 				list.append(szFilename);
 			}
 		}
@@ -985,7 +1093,7 @@ void TypeListBuilder::buildHeaderIncludeElement(QTextStream& os, const RequestRe
 			// Add required include file
 			QString szFilename = getTypeHeaderPath(pElement->getType(), FileCategory_Message);
 			if(!list.contains(szFilename)) {
-				os << "#include \"" << szFilename << "\"" << CRLF;
+				buildInclude(os, pRequestResponseElement->getNamespace(), szFilename);
 				list.append(szFilename);
 			}
 		}
@@ -995,6 +1103,7 @@ void TypeListBuilder::buildHeaderIncludeElement(QTextStream& os, const RequestRe
 void TypeListBuilder::buildHeaderIncludeService(QTextStream& os, const ServiceSharedPtr& pService) const
 {
 	QStringList list;
+	QStringList listModules;
 	bool bSoapEnvelopeFaultIncluded = false;
 
 	os << "#include <QString>" << CRLF;
@@ -1002,7 +1111,8 @@ void TypeListBuilder::buildHeaderIncludeService(QTextStream& os, const ServiceSh
 	os << "#include <QDomDocument>" << CRLF;
 	os << CRLF;
 
-	os << "#include \"Service.h\"" << CRLF << CRLF;
+	os << "#include \"Service.h\"" << CRLF;
+	os << "#include \"OperationBatch.h\"" << CRLF << CRLF;
 
 	QString szTmpFileName;
 
@@ -1022,7 +1132,7 @@ void TypeListBuilder::buildHeaderIncludeService(QTextStream& os, const ServiceSh
 		//qDebug(qPrintable(pOperation->getInputMessage()->getParameter() ? "NotNull" : "Null"));
 
 		if(!bSoapEnvelopeFaultIncluded && pOperation->getSoapEnvelopeFaultType()){
-			os << "#include \"" << getComplexTypeHeaderPath((*operation)->getSoapEnvelopeFaultType(), FileCategory_Service) << "\"" << CRLF;
+			buildServiceInclude(os, getComplexTypeHeaderPath((*operation)->getSoapEnvelopeFaultType(), FileCategory_Service), listModules);
 			bSoapEnvelopeFaultIncluded = true;
 		}
 
@@ -1030,7 +1140,7 @@ void TypeListBuilder::buildHeaderIncludeService(QTextStream& os, const ServiceSh
 		if(pMessage && pMessage->getParameter()){
 			szTmpFileName = getRequestResponseElementHeaderPath(pMessage->getParameter(), FileCategory_Service);
 			if(!list.contains(szTmpFileName)) {
-				os << "#include \"" << szTmpFileName << "\"" << CRLF;
+				buildServiceInclude(os, szTmpFileName, listModules);
 				list.append(szTmpFileName);
 			}
 		}
@@ -1039,7 +1149,7 @@ void TypeListBuilder::buildHeaderIncludeService(QTextStream& os, const ServiceSh
 		if(pMessage && pMessage->getParameter()){
 			szTmpFileName = getRequestResponseElementHeaderPath(pMessage->getParameter(), FileCategory_Service);
 			if(!list.contains(szTmpFileName)) {
-				os << "#include \"" << szTmpFileName << "\"" << CRLF;
+				buildServiceInclude(os, szTmpFileName, listModules);
 				list.append(szTmpFileName);
 			}
 		}
@@ -1083,55 +1193,9 @@ void TypeListBuilder::buildCppClassType(QTextStream& os, const TypeSharedPtr& pT
 	} else if(pType->getTypeMode() == Type::TypeComplex) {
 		ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(pType);
 
-		if(pComplexType->getExtensionType().isNull()) {
-			os << szClassname << "::" << szClassname << "() {";
-			if(pComplexType->getElementList()){
-				ElementList::const_iterator iter;
-				for(iter = pComplexType->getElementList()->constBegin(); iter != pComplexType->getElementList()->constEnd(); ++iter){
-					if((*iter)->getMaxOccurs() == 1){
-						if((*iter)->getType() && ((*iter)->isNested() || (*iter)->isPointer())){
-							os << CRLF << "\t" << (*iter)->getVariableName() << " = NULL;" << CRLF;
-						}
-					}
-				}
-			}
-			os << "}" << CRLF;
-
-			os << szClassname << "::~" << szClassname << "() {";
-			if(pComplexType->getElementList()){
-				ElementList::const_iterator iter;
-				for(iter = pComplexType->getElementList()->constBegin(); iter != pComplexType->getElementList()->constEnd(); ++iter){
-					if((*iter)->getMaxOccurs() == 1){
-						if((*iter)->getType() && ((*iter)->isNested() || (*iter)->isPointer())){
-							os << CRLF << "\tif(" << (*iter)->getVariableName() << "){" << CRLF;
-							os << "\t\tdelete " << (*iter)->getVariableName() << ";" << CRLF;
-							os << "\t\t" << (*iter)->getVariableName() << " = NULL;" << CRLF;
-							os << "\t}" << CRLF;
-						}
-					}
-				}
-			}
-			os << "}" << CRLF;
-			os << CRLF;
-		}else{
-			QString szExtensionName;
-			if(pComplexType->isExtensionTypeList()){
-				szExtensionName = "QList<";
-			}
-			if(pComplexType->getExtensionType()->getTypeMode() == Type::TypeSimple){
-				SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pComplexType->getExtensionType());
-				szExtensionName += pSimpleType->getCPPTypeNameString();
-			}else{
-				szExtensionName += pComplexType->getExtensionType()->getNameWithNamespace();
-			}
-			if(pComplexType->isExtensionTypeList()){
-				szExtensionName += ">";
-			}
-			QString szExtendedClassname = (!m_szPrefix.isEmpty() ? m_szPrefix : "") + szExtensionName;
-
-			os << szClassname << "::" << szClassname << "() : " << szExtendedClassname << "() {}" << CRLF;
-			os << szClassname << "::~" << szClassname << "() {}" << CRLF;
-		}
+		CodeWriter writer;
+		pComplexType->writeLifecycleDefinition(writer, szClassname, getExtendedClassname(pComplexType));
+		writer.flush(os);
 		os << CRLF;
 
 		buildCppClassComplexType(os, pComplexType, pComplexType->getNamespace());
@@ -1153,10 +1217,17 @@ void TypeListBuilder::buildCppClassSimpleType(QTextStream& os, const SimpleTypeS
 
 	os << pSimpleType->getSetterDefinition(szClassname) << CRLF;
 	os << pSimpleType->getGetterDefinition(szClassname) << CRLF;
-	os << pSimpleType->getSerializerDefinition(szClassname) << CRLF;
-	os << pSimpleType->getDeserializerDefinition(szClassname) << CRLF;
-	os << pSimpleType->getEnumConvertDefinition(szClassname) << CRLF;
-	os << pSimpleType->getIsNullDefinition(szClassname) << CRLF;
+
+	CodeWriter writer;
+	pSimpleType->writeSerializerDefinition(writer, szClassname);
+	writer << CodeWriter::EndLine;
+	pSimpleType->writeDeserializerDefinition(writer, szClassname);
+	writer << CodeWriter::EndLine;
+	pSimpleType->writeEnumConvertDefinition(writer, szClassname);
+	writer << CodeWriter::EndLine;
+	pSimpleType->writeIsNullDefinition(writer, szClassname);
+	writer << CodeWriter::EndLine;
+	writer.flush(os);
 	os << CRLF;
 }
 
@@ -1209,11 +1280,31 @@ void TypeListBuilder::buildCppClassComplexType(QTextStream& os, const ComplexTyp
 			os << CRLF;
 		}
 	}
-	os << pComplexType->getSerializerDefinition(szClassname, szTargetNamespace) << CRLF;
-	os << pComplexType->getDeserializerDefinition(szClassname) << CRLF;
-	os << CRLF;
-	os << pComplexType->getIsNullDefinition(szClassname) << CRLF;
-	os << pComplexType->getGetNamespaceDeclarationDefinition(szClassname) << CRLF;
+	CodeWriter writer;
+	if(m_iSerializationMode == SerializationMode_Table && pComplexType->isTableSerializable()) {
+		pComplexType->writeTableSerializerDefinition(writer, szClassname);
+		writer << CodeWriter::EndLine;
+		pComplexType->writeTableDeserializerDefinition(writer, szClassname);
+	}else{
+		pComplexType->writeSerializerDefinition(writer, szClassname, szTargetNamespace);
+		writer << CodeWriter::EndLine;
+		pComplexType->writeDeserializerDefinition(writer, szClassname);
+		writer << CodeWriter::EndLine;
+		pComplexType->writeStreamDeserializerDefinition(writer, szClassname);
+	}
+	writer << CodeWriter::EndLine;
+	writer << CodeWriter::EndLine;
+	pComplexType->writeIsNullDefinition(writer, szClassname);
+	writer << CodeWriter::EndLine;
+	pComplexType->writeGetNamespaceDeclarationDefinition(writer, szClassname);
+	writer << CodeWriter::EndLine;
+	pComplexType->writeArenaOperatorsDefinition(writer, szClassname);
+	writer << CodeWriter::EndLine;
+	if(m_iSerializationMode == SerializationMode_Table) {
+		pComplexType->writeTypeDescriptorDefinition(writer, szClassname, szTargetNamespace);
+		writer << CodeWriter::EndLine;
+	}
+	writer.flush(os);
 }
 
 void TypeListBuilder::buildCppClassElement(QTextStream& os, const RequestResponseElementSharedPtr& pElement) const
@@ -1239,8 +1330,9 @@ void TypeListBuilder::buildCppClassElement(QTextStream& os, const RequestRespons
 	os << CRLF;
 
 	if(!pComplexType.isNull()) {
-		os << szClassname << "::" << szClassname << "() {}" << CRLF;
-		os << szClassname << "::~" << szClassname << "() {}" << CRLF;
+		CodeWriter writer;
+		pComplexType->writeLifecycleDefinition(writer, szClassname, getExtendedClassname(pComplexType));
+		writer.flush(os);
 		os << CRLF;
 
 		buildCppClassComplexType(os, pComplexType, pComplexType->getNamespace());
@@ -1261,6 +1353,12 @@ void TypeListBuilder::buildCppClassService(QTextStream& os, const ServiceSharedP
 
 	os << szClassname << "::" << szClassname << "() {" << CRLF;
 	os << "\tm_bDebug = false;" << CRLF;
+	QMap<QString, int>::const_iterator iterTtl;
+	for(iterTtl = m_mapOperationCacheTtl.constBegin(); iterTtl != m_mapOperationCacheTtl.constEnd(); ++iterTtl) {
+		if(pService->getOperationList()->getByName(iterTtl.key())) {
+			os << "\tsetOperationCacheTtl(\"" << iterTtl.key() << "\", " << iterTtl.value() << ");" << CRLF;
+		}
+	}
 	os << "}" << CRLF;
 	os << CRLF;
 	os << szClassname << "::~" << szClassname << "() {}" << CRLF;
@@ -1270,37 +1368,33 @@ void TypeListBuilder::buildCppClassService(QTextStream& os, const ServiceSharedP
 	os << "}" << CRLF;
 	os << CRLF;
 
+	CodeWriter writer;
 	OperationListSharedPtr pOperationList = pService->getOperationList();
 	OperationList::const_iterator operation;
 	for(operation = pOperationList->constBegin(); operation != pOperationList->constEnd(); ++operation) {
 		if(!(*operation)->getInputMessage()) {
 			continue;
 		}
-		os << (*operation)->getOperationDefinition(szClassname, m_szNamespace) << CRLF;
+		(*operation)->writeOperationDefinition(writer, szClassname, m_szNamespace);
+		writer << CodeWriter::EndLine;
 	}
+	writer.flush(os);
 
 	os << "QMap<QString, QString> " << szClassname << "::buildNamespaceRoutingMap(const QDomDocument& doc) const" CRLF;
 	os << "{" CRLF;
 	os << "\tQMap<QString, QString> map;" CRLF;
-	os << "\tQString szSoapEnvNamespace = DEFAULT_SOAP_ENV_NAMESPACE;" CRLF;
-	os << CRLF;
-	os << "\t// Try to find the real soap envelope namespace" CRLF;
-	os << "\tQDomNode node = doc.documentElement();" CRLF;
-	os << "\twhile(!node.isNull()){" CRLF;
-	os << "\t\tQDomElement elem = node.toElement();" CRLF;
-	os << "\t\tif(!elem.isNull() && elem.tagName().endsWith(\":Envelope\")){" CRLF;
-	os << "\t\t\tszSoapEnvNamespace = elem.tagName().split(\":\")[0];" CRLF;
-	os << "\t\t}" CRLF;
-	os << "\t\tnode = node.nextSibling();" CRLF;
-	os << "\t}" CRLF;
 	os << CRLF;
-	os << "\tif(doc.elementsByTagName(szSoapEnvNamespace + \":Envelope\").size() > 0){" << CRLF;
-	os << "\t\tQDomElement root = doc.elementsByTagName(szSoapEnvNamespace + \":Envelope\").at(0).toElement();" << CRLF;
-	os << "\t\tint iNbAttributes = root.attributes().size();" << CRLF;
+	os << "\t// The envelope is the document element, its declarations give the prefixes" CRLF;
+	os << "\tQDomElement root = doc.documentElement();" CRLF;
+	os << "\tif(!root.isNull() && root.tagName().endsWith(\"Envelope\")){" << CRLF;
+	os << "\t\tQDomNamedNodeMap attributes = root.attributes();" << CRLF;
+	os << "\t\tint iNbAttributes = attributes.size();" << CRLF;
 	os << "\t\tfor(int i = 0; i < iNbAttributes; ++i){" << CRLF;
-	os << "\t\t\tQDomAttr attr = root.attributes().item(i).toAttr();" << CRLF;
+	os << "\t\t\tQDomAttr attr = attributes.item(i).toAttr();" << CRLF;
 	os << "\t\t\tQStringList nameList = attr.name().split(\":\");" << CRLF;
-	os << "\t\t\tmap.insert(attr.value(), nameList[1]);" << CRLF;
+	os << "\t\t\tif(nameList.size() == 2){" << CRLF;
+	os << "\t\t\t\tmap.insert(attr.value(), nameList[1]);" << CRLF;
+	os << "\t\t\t}" CRLF;
 	os << "\t\t}" CRLF;
 	os << "\t}" CRLF;
 	os << "\treturn map;" CRLF;
@@ -1312,31 +1406,40 @@ void TypeListBuilder::startCppClass(QTextStream& os, const QString& szClassName,
 	os << "class " << szClassName;
 	if(!pComplexType->getExtensionType().isNull())
 	{
-		QString szExtendedClassname;
-		if(pComplexType->isExtensionTypeList()){
-			szExtendedClassname = "QList<";
-		}
-		if(pComplexType->getExtensionType()->getTypeMode() == Type::TypeSimple){
-			SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pComplexType->getExtensionType());
-			szExtendedClassname += pSimpleType->getCPPTypeNameString();
-		}else{
-			QString szExtensionName = pComplexType->getExtensionType()->getNameWithNamespace();
-			szExtendedClassname += (!m_szPrefix.isEmpty() ? m_szPrefix : "") + szExtensionName;
-		}
-		if(pComplexType->isExtensionTypeList()){
-			szExtendedClassname += ">";
-		}
-
-		os << " : public " << szExtendedClassname;
+		os << " : public " << getExtendedClassname(pComplexType);
 	}
 	os << CRLF;
 	os << "{" << CRLF;
 	os << "public:" << CRLF;
 	os << "\t" << szClassName << "();" << CRLF;
 	os << "\tvirtual ~" << szClassName << "();" << CRLF;
+	os << "\t" << pComplexType->getCopyMoveDeclaration(szClassName) << CRLF;
 	os << CRLF;
 }
 
+QString TypeListBuilder::getExtendedClassname(const ComplexTypeSharedPtr& pComplexType) const
+{
+	QString szExtendedClassname;
+	if(pComplexType->getExtensionType().isNull()){
+		return szExtendedClassname;
+	}
+
+	if(pComplexType->isExtensionTypeList()){
+		szExtendedClassname = "QList<";
+	}
+	if(pComplexType->getExtensionType()->getTypeMode() == Type::TypeSimple){
+		SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pComplexType->getExtensionType());
+		szExtendedClassname += pSimpleType->getCPPTypeNameString();
+	}else{
+		QString szExtensionName = pComplexType->getExtensionType()->getNameWithNamespace();
+		szExtendedClassname += (!m_szPrefix.isEmpty() ? m_szPrefix : "") + szExtensionName;
+	}
+	if(pComplexType->isExtensionTypeList()){
+		szExtendedClassname += ">";
+	}
+	return szExtendedClassname;
+}
+
 void TypeListBuilder::endCppClass(QTextStream& os) const
 {
 	os << "};" << CRLF;
@@ -1374,7 +1477,7 @@ void TypeListBuilder::buildTypeIncludes(QTextStream& os, const TypeSharedPtr& pT
 			ElementList::const_iterator iter;
 			for(iter = pComplexType->getElementList()->constBegin(); iter != pComplexType->getElementList()->constEnd(); ++iter){
 				if((*iter)->getType() && (*iter)->isPointer()){
-					os << "#include \"" << getTypeHeaderPath((*iter)->getType(), FileCategory_Type) << "\"" << CRLF;
+					buildInclude(os, pType->getNamespace(), getTypeHeaderPath((*iter)->getType(), FileCategory_Type));
 					bHasIncludes = true;
 				}
 			}
@@ -1385,3 +1488,177 @@ void TypeListBuilder::buildTypeIncludes(QTextStream& os, const TypeSharedPtr& pT
 		}
 	}
 }
+
+QString TypeListBuilder::getTypeDirectoryNamespace(const TypeSharedPtr& pType)
+{
+	if(pType->getTypeMode() == Type::TypeSimple){
+		SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pType);
+		if(!pSimpleType->hasVariableType()){
+			return QString();
+		}
+		return getSimpleTypeNamespace(pSimpleType).toLower();
+	}
+	return pType->getNamespace().toLower();
+}
+
+void TypeListBuilder::addNamespaceDependency(const QString& szNamespace, const TypeSharedPtr& pType)
+{
+	if(!m_pNamespaceDependencyMap || !pType){
+		return;
+	}
+	m_pNamespaceDependencyMap->addNamespace(szNamespace.toLower());
+	m_pNamespaceDependencyMap->addDependency(szNamespace.toLower(), getTypeDirectoryNamespace(pType));
+}
+
+void TypeListBuilder::addNamespaceDependencies(const QString& szNamespace, const TypeSharedPtr& pType)
+{
+	if(!m_pNamespaceDependencyMap || !pType){
+		return;
+	}
+
+	m_pNamespaceDependencyMap->addNamespace(szNamespace.toLower());
+
+	if(pType->getTypeMode() == Type::TypeSimple){
+		SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pType);
+		if(pSimpleType->hasVariableType()){
+			m_pNamespaceDependencyMap->addDependency(szNamespace.toLower(), getSimpleTypeNamespace(pSimpleType).toLower());
+		}
+	}else if(pType->getTypeMode() == Type::TypeComplex){
+		ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(pType);
+
+		addNamespaceDependency(szNamespace, pComplexType->getExtensionType());
+
+		AttributeListSharedPtr pListAttributes = pComplexType->getAttributeList();
+		AttributeList::const_iterator attr;
+		AttributeSharedPtr pAttribute;
+		for(attr = pListAttributes->constBegin(); attr != pListAttributes->constEnd(); ++attr) {
+			if((*attr)->hasRef()){
+				pAttribute = (*attr)->getRef();
+			}else{
+				pAttribute = *attr;
+			}
+			addNamespaceDependency(szNamespace, pAttribute->getType());
+		}
+
+		ElementListSharedPtr pListElements = pComplexType->getElementList();
+		ElementList::const_iterator element;
+		ElementSharedPtr pElement;
+		for(element = pListElements->constBegin(); element != pListElements->constEnd(); ++element) {
+			if((*element)->hasRef()){
+				pElement = (*element)->getRef();
+			}else{
+				pElement = *element;
+			}
+			if(!pElement->isNested()){
+				addNamespaceDependency(szNamespace, pElement->getType());
+			}
+		}
+	}
+}
+
+void TypeListBuilder::addReportEntry(const QString& szHeaderFile, const QString& szCppFile, const QString& szName, const QString& szCategory, const TypeSharedPtr& pType, bool bWithPointers)
+{
+	if(!m_pGenerationReport || !pType){
+		return;
+	}
+
+	m_pGenerationReport->addEntry(szHeaderFile, szCppFile, szName, szCategory);
+
+	if(pType->getTypeMode() == Type::TypeSimple){
+		SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pType);
+		if(pSimpleType->hasVariableType()){
+			m_pGenerationReport->addDependency(szHeaderFile, getSimpleTypeHeaderPath(pSimpleType, FileCategory_Service));
+		}
+	}else if(pType->getTypeMode() == Type::TypeComplex){
+		ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(pType);
+		int iListMemberCount = 0;
+
+		if(pComplexType->getExtensionType()){
+			m_pGenerationReport->addDependency(szHeaderFile, getTypeHeaderPath(pComplexType->getExtensionType(), FileCategory_Service));
+		}
+
+		AttributeListSharedPtr pListAttributes = pComplexType->getAttributeList();
+		AttributeList::const_iterator attr;
+		AttributeSharedPtr pAttribute;
+		for(attr = pListAttributes->constBegin(); attr != pListAttributes->constEnd(); ++attr) {
+			if((*attr)->hasRef()){
+				pAttribute = (*attr)->getRef();
+			}else{
+				pAttribute = *attr;
+			}
+			if(!pAttribute->getType()){
+				continue;
+			}
+			if(pAttribute->isList()){
+				iListMemberCount++;
+			}
+			m_pGenerationReport->addDependency(szHeaderFile, getTypeHeaderPath(pAttribute->getType(), FileCategory_Service));
+		}
+
+		ElementListSharedPtr pListElements = pComplexType->getElementList();
+		ElementList::const_iterator element;
+		ElementSharedPtr pElement;
+		for(element = pListElements->constBegin(); element != pListElements->constEnd(); ++element) {
+			if((*element)->hasRef()){
+				pElement = (*element)->getRef();
+			}else{
+				pElement = *element;
+			}
+			if(!pElement->getType()){
+				continue;
+			}
+			if(pElement->getMaxOccurs() > 1 || pElement->getMaxOccurs() == -1){
+				iListMemberCount++;
+			}
+
+			QString szDependencyHeaderFile = getTypeHeaderPath(pElement->getType(), FileCategory_Service);
+			if(pElement->isNested()){
+				m_pGenerationReport->markNested(szDependencyHeaderFile);
+				continue;
+			}
+			if(pElement->isPointer()){
+				m_pGenerationReport->markPointer(szDependencyHeaderFile);
+				if(!bWithPointers){
+					// Only declared in the header, the include is in the .cpp
+					continue;
+				}
+			}
+			m_pGenerationReport->addDependency(szHeaderFile, szDependencyHeaderFile);
+		}
+
+		m_pGenerationReport->setListMemberCount(szHeaderFile, iListMemberCount);
+	}
+}
+
+void TypeListBuilder::buildInclude(QTextStream& os, const QString& szNamespace, const QString& szFilename) const
+{
+	QString szFileNamespace = FileHelper::getFileNamespace(szFilename);
+	if(m_bModuleOutput && !szFileNamespace.isEmpty() && szFileNamespace != szNamespace.toLower()){
+		// In a module purview the declarations of the other namespaces come from their imported module
+		os << "#ifndef " << FileHelper::buildModulePurviewDefine(m_szNamespace) << CRLF;
+		os << "#include \"" << szFilename << "\"" << CRLF;
+		os << "#endif" << CRLF;
+	}else{
+		os << "#include \"" << szFilename << "\"" << CRLF;
+	}
+}
+
+void TypeListBuilder::buildServiceInclude(QTextStream& os, const QString& szFilename, QStringList& listModules) const
+{
+	QString szFileNamespace = FileHelper::getFileNamespace(szFilename);
+	if(m_bModuleOutput && !szFileNamespace.isEmpty()){
+		QString szModuleName = FileHelper::buildModuleName(m_szNamespace, szFileNamespace);
+		if(!listModules.contains(szModuleName)){
+			os << "import " << szModuleName << ";" << CRLF;
+			listModules.append(szModuleName);
+		}
+	}else{
+		os << "#include \"" << szFilename << "\"" << CRLF;
+	}
+}
+
+const char* TypeListBuilder::getConstantQualifier() const
+{
+	// A const variable has internal linkage and cannot be exported from a module
+	return m_bModuleOutput ? "inline const " : "const ";
+}
@@ -9,6 +9,7 @@
 #define TYPELISTBUILDER_H_
 
 #include <QFile>
+#include <QMap>
 #include <QTextStream>
 
 #include "Model/RequestResponseElement.h"
@@ -17,6 +18,9 @@
 #include "Model/Type.h"
 #include "Model/Service.h"
 
+#include "Builder/GenerationReport.h"
+
+#include "Utils/NamespaceDependencyMap.h"
 #include "Utils/UniqueStringList.h"
 
 class TypeListBuilder
@@ -29,6 +33,11 @@ public:
 		FileCategory_Service,
 	};
 
+	enum SerializationMode {
+		SerializationMode_Default,
+		SerializationMode_Table,
+	};
+
 public:
 	TypeListBuilder(const ServiceSharedPtr& pService, const TypeListSharedPtr& pListType, const RequestResponseElementListSharedPtr& pListElement, const QSharedPointer<UniqueStringList>& pListGeneratedFiles);
 	virtual ~TypeListBuilder();
@@ -45,6 +54,26 @@ public:
 	void setDirname(const QString& szDirname);
 	QString getDirname() const;
 
+	void setSerializationMode(SerializationMode iSerializationMode);
+	SerializationMode getSerializationMode() const;
+
+	// Filled with the namespace dependencies of the generated files when set
+	void setNamespaceDependencyMap(const NamespaceDependencyMapSharedPtr& pNamespaceDependencyMap);
+	NamespaceDependencyMapSharedPtr getNamespaceDependencyMap() const;
+
+	// Filled with an entry for each generated type and message when set
+	void setGenerationReport(const GenerationReportSharedPtr& pGenerationReport);
+	GenerationReportSharedPtr getGenerationReport() const;
+
+	// Prepare the generated files to be included in a C++20 module per namespace
+	void setModuleOutput(bool bModuleOutput);
+	bool isModuleOutput() const;
+
+	// Time to live in milliseconds of the cached responses of the operations, set by the
+	// generated service constructor
+	void setOperationCacheTtlMap(const QMap<QString, int>& mapOperationCacheTtl);
+	QMap<QString, int> getOperationCacheTtlMap() const;
+
 	static QString getHeaderPath(const QString& szNamespace, const QString& szCategory, const QString& szFilename, FileCategory iOrigin);
 	static QString getTypeHeaderPath(const TypeSharedPtr& pType, FileCategory iOrigin);
 	static QString getSimpleTypeHeaderPath(const SimpleTypeSharedPtr& pSimpleType, FileCategory iOrigin);
@@ -95,8 +124,19 @@ private:
 
 	void startCppClass(QTextStream& os, const QString& szClassName, const ComplexTypeSharedPtr& pComplexType) const;
 	void endCppClass(QTextStream& os) const;
+	// Base class of a complex type with extension, empty otherwise
+	QString getExtendedClassname(const ComplexTypeSharedPtr& pComplexType) const;
 
 	void buildTypeIncludes(QTextStream& os, const TypeSharedPtr& pType);
+	void buildInclude(QTextStream& os, const QString& szNamespace, const QString& szFilename) const;
+	void buildServiceInclude(QTextStream& os, const QString& szFilename, QStringList& listModules) const;
+	const char* getConstantQualifier() const;
+
+	static QString getTypeDirectoryNamespace(const TypeSharedPtr& pType);
+	void addNamespaceDependency(const QString& szNamespace, const TypeSharedPtr& pType);
+	void addNamespaceDependencies(const QString& szNamespace, const TypeSharedPtr& pType);
+
+	void addReportEntry(const QString& szHeaderFile, const QString& szCppFile, const QString& szName, const QString& szCategory, const TypeSharedPtr& pType, bool bWithPointers);
 
 	TypeListSharedPtr m_pListType;
 	RequestResponseElementListSharedPtr m_pListElement;
@@ -108,6 +148,13 @@ private:
 	QString m_szNamespace;
 	QString m_szFilename;
 	QString m_szDirname;
+
+	SerializationMode m_iSerializationMode;
+	bool m_bModuleOutput;
+	QMap<QString, int> m_mapOperationCacheTtl;
+
+	NamespaceDependencyMapSharedPtr m_pNamespaceDependencyMap;
+	GenerationReportSharedPtr m_pGenerationReport;
 };
 
 #endif /* TYPELISTBUILDER_H_ */
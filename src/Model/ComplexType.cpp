@@ -5,8 +5,14 @@
  *      Author: lgruber
  */
 
+#include <QMap>
+#include <QPair>
+#include <QSet>
+#include <QStringList>
+
 #include "../Utils/StringUtils.h"
 #include "../Utils/ModelUtils.h"
+#include "../Utils/CodeWriter.h"
 
 #include "SimpleType.h"
 #include "ComplexType.h"
@@ -152,6 +158,7 @@ QString Element::getTagQualifiedName() const
 QString Element::getSetterDeclaration() const
 {
 	QString szDeclaration;
+	QString szMoveDeclaration;
 
 	QString szFuncName = ModelUtils::getCapitalizedName(getName());
 	QString szParamType;
@@ -164,8 +171,11 @@ QString Element::getSetterDeclaration() const
 		if(m_iMaxOccurs > 1 || m_iMaxOccurs == -1) {
 			szDeclaration += "void set%0List(const QList<%1>& %2List);" CRLF;
 			szDeclaration += "\tvoid add%0(const %1& %2);";
+			szMoveDeclaration += "\tvoid set%0List(QList<%1>&& %2List);" CRLF;
+			szMoveDeclaration += "\tvoid add%0(%1&& %2);" CRLF;
 		}else{
 			szDeclaration = "void set%0(const %1& %2);";
+			szMoveDeclaration = "\tvoid set%0(%1&& %2);" CRLF;
 		}
 	}else{
 		ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(m_pType);
@@ -177,6 +187,8 @@ QString Element::getSetterDeclaration() const
 			}else{
 				szDeclaration = "void set%0List(const QList<%1>& %2);" CRLF;
 				szDeclaration += "\tvoid add%0(const %1& %2);";
+				szMoveDeclaration += "\tvoid set%0List(QList<%1>&& %2);" CRLF;
+				szMoveDeclaration += "\tvoid add%0(%1&& %2);" CRLF;
 			}
 		}else{
 			if(m_bIsNested || m_bIsPointer){
@@ -184,10 +196,18 @@ QString Element::getSetterDeclaration() const
 				szParamType = pComplexType->getLocalName();
 			}else{
 				szDeclaration = QString("void set%0(const %1& %2);");
+				szMoveDeclaration = "\tvoid set%0(%1&& %2);" CRLF;
 				szParamType = pComplexType->getNameWithNamespace();
 			}
 		}
 	}
+
+	// Overloads taking the value by rvalue reference to avoid a copy
+	if(!szMoveDeclaration.isEmpty()){
+		szDeclaration += CRLF "#ifdef Q_COMPILER_RVALUE_REFS" CRLF;
+		szDeclaration += szMoveDeclaration;
+		szDeclaration += "#endif";
+	}
 	return szDeclaration.arg(szFuncName).arg(szParamType).arg(szParamName);
 }
 
@@ -258,6 +278,7 @@ QString Element::getDeserializerDeclaration() const
 QString Element::getSetterDefinition(const QString& szClassname) const
 {
 	QString szDefinition;
+	QString szMoveDefinition;
 
 	QString szFuncName = ModelUtils::getCapitalizedName(getName());
 	QString szMemberName;
@@ -279,12 +300,26 @@ QString Element::getSetterDefinition(const QString& szClassname) const
 			szDefinition += "{" CRLF;
 			szDefinition += "\t%4.append(%3);" CRLF;
 			szDefinition += "}" CRLF;;
+
+			szMoveDefinition += "void %0::set%1List(QList<%2>&& %3List)" CRLF;
+			szMoveDefinition += "{" CRLF;
+			szMoveDefinition += "\t%4 = std::move(%3List);" CRLF;
+			szMoveDefinition += "}" CRLF CRLF;
+			szMoveDefinition += "void %0::add%1(%2&& %3)" CRLF;
+			szMoveDefinition += "{" CRLF;
+			szMoveDefinition += "\t%4.append(std::move(%3));" CRLF;
+			szMoveDefinition += "}" CRLF;
 		}else{
 			szMemberName = getVariableName();
 			szDefinition += "void %0::set%1(const %2& %3)" CRLF;
 			szDefinition += "{" CRLF;
 			szDefinition += "\t%4 = %3;" CRLF;
 			szDefinition += "}" CRLF;
+
+			szMoveDefinition += "void %0::set%1(%2&& %3)" CRLF;
+			szMoveDefinition += "{" CRLF;
+			szMoveDefinition += "\t%4 = std::move(%3);" CRLF;
+			szMoveDefinition += "}" CRLF;
 		}
 	}else{
 		ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(m_pType);
@@ -292,9 +327,13 @@ QString Element::getSetterDefinition(const QString& szClassname) const
 			szParamType = pComplexType->getNameWithNamespace();
 			szMemberName = getVariableNameList();
 			if(m_bIsPointer){
+				// The items are owned
 				szDefinition += "void %0::set%1List(const QList<%2*>& %3List)" CRLF;
 				szDefinition += "{" CRLF;
-				szDefinition += "\t%4 = %3List;" CRLF;
+				szDefinition += "\tif(&%4 != &%3List) {" CRLF;
+				szDefinition += "\t\tqDeleteAll(%4);" CRLF;
+				szDefinition += "\t\t%4 = %3List;" CRLF;
+				szDefinition += "\t}" CRLF;
 				szDefinition += "}" CRLF CRLF;
 				szDefinition += "void %0::add%1(%2* %3)" CRLF;
 				szDefinition += "{" CRLF;
@@ -309,6 +348,15 @@ QString Element::getSetterDefinition(const QString& szClassname) const
 				szDefinition += "{" CRLF;
 				szDefinition += "\t%4.append(%3);" CRLF;
 				szDefinition += "}" CRLF;
+
+				szMoveDefinition += "void %0::set%1List(QList<%2>&& %3)" CRLF;
+				szMoveDefinition += "{" CRLF;
+				szMoveDefinition += "\t%4 = std::move(%3);" CRLF;
+				szMoveDefinition += "}" CRLF CRLF;
+				szMoveDefinition += "void %0::add%1(%2&& %3)" CRLF;
+				szMoveDefinition += "{" CRLF;
+				szMoveDefinition += "\t%4.append(std::move(%3));" CRLF;
+				szMoveDefinition += "}" CRLF;
 			}
 		}else{
 			szMemberName = getVariableName();
@@ -326,10 +374,21 @@ QString Element::getSetterDefinition(const QString& szClassname) const
 				szDefinition += "{" CRLF;
 				szDefinition += "\t%4 = %3;" CRLF;
 				szDefinition += "}" CRLF;
+
+				szMoveDefinition += "void %0::set%1(%2&& %3)" CRLF;
+				szMoveDefinition += "{" CRLF;
+				szMoveDefinition += "\t%4 = std::move(%3);" CRLF;
+				szMoveDefinition += "}" CRLF;
 			}
 		}
 	}
 
+	if(!szMoveDefinition.isEmpty()){
+		szDefinition += CRLF "#ifdef Q_COMPILER_RVALUE_REFS" CRLF;
+		szDefinition += szMoveDefinition;
+		szDefinition += "#endif" CRLF;
+	}
+
 	szDefinition = szDefinition.arg(szClassname);
 	szDefinition = szDefinition.arg(szFuncName);
 	szDefinition = szDefinition.arg(szParamType);
@@ -409,71 +468,27 @@ QString Element::getGetterDefinition(const QString& szClassname) const
 	return szDefinition.arg(szMemberType).arg(szClassname).arg(szFuncName).arg(szMemberName);
 }
 
-QString Element::getSerializerDefinition(const QString& szClassname, const QString& szNamespace) const
-{
-	if(m_pType->getTypeMode() == Type::TypeSimple) {
-		SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(m_pType);
-		return pSimpleType->getVariableDeclaration();
-
-	}else{
-		ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(m_pType);
-		return pComplexType->getSerializerDefinition(szClassname, szNamespace);
-	}
-}
-
-QString Element::getDeserializerDefinition(const QString& szClassname) const
+void Element::writeVariableDeclaration(CodeWriter& writer) const
 {
-	if(m_pType->getTypeMode() == Type::TypeSimple) {
-		SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(m_pType);
-		return pSimpleType->getDeserializerDefinition(szClassname);
-
-	}else{
-		ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(m_pType);
-		return pComplexType->getDeserializerDefinition(szClassname);
-	}
-}
-
-QString Element::getVariableDeclaration() const
-{
-	QString szDeclaration;
-
-	QString szVariableName = getVariableName();
-
 	if(m_pType->getTypeMode() == Type::TypeSimple)
 	{
 		SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(m_pType);
 
 		if(m_iMaxOccurs > 1 || m_iMaxOccurs == -1) {
-			szDeclaration += "QList<";
-			szDeclaration += pSimpleType->getCPPTypeNameString();
-			szDeclaration += "> ";
-			szDeclaration += szVariableName;
-			szDeclaration += "List";
-			szDeclaration += ";";
+			writer << "QList<" << pSimpleType->getCPPTypeNameString() << "> " << getVariableNameList() << ";";
 		} else {
-			szDeclaration += pSimpleType->getCPPTypeNameString();
-			szDeclaration += " ";
-			szDeclaration += szVariableName;
-			szDeclaration += ";";
+			writer << pSimpleType->getCPPTypeNameString() << " " << getVariableName() << ";";
 		}
 	}else{
-		ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(m_pType);
-
 		if(m_iMaxOccurs > 1 || m_iMaxOccurs == -1) {
-			szDeclaration += "QList<";
-			szDeclaration += m_pType->getNameWithNamespace() + (m_bIsPointer ? "*" : "");
-			szDeclaration += "> ";
-			szDeclaration += szVariableName;
-			szDeclaration += "List";
+			writer << "QList<" << m_pType->getNameWithNamespace() << (m_bIsPointer ? "*" : "") << "> " << getVariableNameList() << ";";
+		} else if(m_bIsNested || m_bIsPointer) {
+			writer << m_pType->getLocalName() << "* " << getVariableName() << ";";
 		} else {
-			szDeclaration += (m_bIsNested || m_bIsPointer) ? m_pType->getLocalName() : m_pType->getNameWithNamespace();
-			szDeclaration += (m_bIsNested || m_bIsPointer) ? "* " : " ";
-			szDeclaration += szVariableName;
+			writer << m_pType->getNameWithNamespace() << " " << getVariableName() << ";";
 		}
-		szDeclaration += ";";
 	}
-
-	return szDeclaration;
+	writer << CodeWriter::EndLine;
 }
 
 ElementList::ElementList()
@@ -658,37 +673,24 @@ QString Attribute::getGetterDeclaration() const
 	return szDeclaration;
 }
 
-QString Attribute::getVariableDeclaration() const
+void Attribute::writeVariableDeclaration(CodeWriter& writer) const
 {
-	QString szDeclaration;
-
 	if(m_pType->getTypeMode() == Type::TypeSimple) {
 		SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(m_pType);
 		if(m_bIsList){
-			szDeclaration += "QList<";
-			szDeclaration += pSimpleType->getCPPTypeNameString();
-			szDeclaration += "> ";
-			szDeclaration +=  getVariableName();
-			szDeclaration += "List";
-			szDeclaration += ";";
+			writer << "QList<" << pSimpleType->getCPPTypeNameString() << "> " << getVariableNameList() << ";";
 		}else{
-			szDeclaration += pSimpleType->getVariableDeclarationForComplexType() ;
+			writer << pSimpleType->getVariableDeclarationForComplexType();
 		}
 	}else if(m_pType->getTypeMode() == Type::TypeComplex) {
 		ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(m_pType);
 		if(m_bIsList){
-			szDeclaration += "QList<";
-			szDeclaration += pComplexType->getNameWithNamespace();
-			szDeclaration += "> ";
-			szDeclaration += getVariableName();
-			szDeclaration += "List";
-			szDeclaration += ";";
+			writer << "QList<" << pComplexType->getNameWithNamespace() << "> " << getVariableNameList() << ";";
 		}else{
-			szDeclaration += pComplexType->getVariableDeclaration(getName());
+			writer << pComplexType->getVariableDeclaration(getName());
 		}
 	}
-
-	return szDeclaration;
+	writer << CodeWriter::EndLine;
 }
 
 QString Attribute::getSetterDefinition(const QString& szClassname) const
@@ -954,9 +956,18 @@ QString ComplexType::getSerializerDeclaration() const
 	return "QString serialize(bool bOnlyContent = false) const;";
 }
 
+QString ComplexType::getBufferSerializerDeclaration() const
+{
+	return "void serialize(QByteArray& buffer, bool bOnlyContent = false) const;";
+}
+
 QString ComplexType::getDeserializerDeclaration() const
 {
-	return "void deserialize(QDomElement& element);";
+	QString szRet = "void deserialize(QDomElement& element);";
+	szRet += CRLF "\tvoid deserialize(QXmlStreamReader& reader);";
+	szRet += CRLF "\tvoid deserializeAttributes(const QXmlStreamAttributes& attributes);";
+	szRet += CRLF "\tbool deserializeElement(QXmlStreamReader& reader);";
+	return szRet;
 }
 
 QString ComplexType::getSetterDefinition(const QString& szClassname, const QString& szName) const
@@ -992,7 +1003,7 @@ QString ComplexType::getGetterDefinition(const QString& szClassname, const QStri
 	return szDefinition.arg(szMemberType).arg(szClassname).arg(szFuncName).arg(szMemberName);
 }
 
-QString ComplexType::getSerializerDefinition(const QString& szClassname, const QString& szNamespace) const
+void ComplexType::writeSerializerDefinition(CodeWriter& writer, const QString& szClassname, const QString& szNamespace) const
 {
 	AttributeList::const_iterator attr;
 	ElementList::const_iterator elem;
@@ -1002,13 +1013,19 @@ QString ComplexType::getSerializerDefinition(const QString& szClassname, const Q
 	QString szIterator;
 	int iIteratorCount = 0;
 
-	QString szDefinition = ""
-	"QString %0::serialize(bool bOnlyContent) const" CRLF
-	"{" CRLF
-	"\tQString szValue;" CRLF
-	"\tif(!bOnlyContent) {" CRLF
-	"\t\tszValue += \"<%1:%2\";" CRLF
-	"\t}" CRLF;
+	writer << "QString " << szClassname << "::serialize(bool bOnlyContent) const" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "QByteArray buffer;" << CodeWriter::EndLine;
+	writer << "serialize(buffer, bOnlyContent);" << CodeWriter::EndLine;
+	writer << "return QString::fromUtf8(buffer);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+
+	writer << "void " << szClassname << "::serialize(QByteArray& buffer, bool bOnlyContent) const" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "if(!bOnlyContent) " << CodeWriter::BeginBlock;
+	writer << "buffer += \"<" << szNamespace << ":" << getLocalName() << "\";" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
 
 	//Not found other cases so we supposed attribute is only a simpleType
 	for(attr = m_pListAttribute->constBegin(); attr != m_pListAttribute->constEnd(); ++attr) {
@@ -1018,46 +1035,54 @@ QString ComplexType::getSerializerDefinition(const QString& szClassname, const Q
 			pAttribute = *attr;
 		}
 
-		if(pAttribute->getType()){
-			if(pAttribute->getType()->getTypeMode() == Type::TypeSimple) {
-				SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pAttribute->getType());
-				if(pAttribute->isList()){
-					szIterator = "iter_" + QString::number(iIteratorCount++);
-					szDefinition += "\tif(_" + pAttribute->getName() + "List" + ".size() > 0) {" CRLF;
-					szDefinition += "\t\tszValue += \" " + pAttribute->getName() + "=\\\"\";" CRLF;
-					szDefinition += QString("\t\tQList<%0>::const_iterator %1;" CRLF).arg( pSimpleType->getCPPTypeNameString()).arg(szIterator);
-					szDefinition += QString("\t\tfor(%0 = _%1List.constBegin(); %0 != _%1List.constEnd(); ++%0) {" CRLF).arg(szIterator).arg(pAttribute->getName());
-					szDefinition += QString("\t\t\tif(!%0->isNull()) {" CRLF).arg(szIterator);
-					szDefinition += QString("\t\t\t\tszValue += %0->serialize() + \" \";" CRLF).arg(szIterator);
-					szDefinition += QString("\t\t\t}" CRLF);
-					szDefinition += "\t\t}" CRLF;
-					szDefinition += "\t\tszValue +=\"\\\"\";" CRLF;
-					szDefinition += "\t}" CRLF;
-				}else{
-					szDefinition += "\tif(!" + pSimpleType->getVariableName() + ".isNull()) {" CRLF;
-					szDefinition += "\t\tszValue += \" " + pAttribute->getName() + "=\\\"\" + " + pSimpleType->getVariableName() + ".serialize() + \"\\\"\";" CRLF;
-					szDefinition += "\t}" CRLF;
-				}
-			}else if(pAttribute->getType()->getTypeMode() == Type::TypeComplex){
-				ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(pAttribute->getType());
-				if(pAttribute->isList()){
-					szIterator = "iter_" + QString::number(iIteratorCount++);
-					szDefinition += "\tif(" + pAttribute->getName() + "List" + ".size() > 0) {" CRLF;
-					szDefinition += "\t\tszValue += \" " + pAttribute->getName() + "=\\\"\"" CRLF;
-					szDefinition += QString("\t\tQList<%0>::const_iterator %1;" CRLF).arg( pComplexType->getNameWithNamespace()).arg(szIterator);
-					szDefinition += QString("\t\tfor(%0 = %1List.constBegin(); %0 != %1List.constEnd(); ++%0) {" CRLF).arg(szIterator).arg(pAttribute->getName());
-					szDefinition += QString("\t\t\tif(!(*%0)->isNull()) {" CRLF).arg(szIterator);
-					szDefinition += QString("\t\t\t\tszValue += (*%0)->serialize() + \" \";" CRLF).arg(szIterator);
-					szDefinition += QString("\t\t\t}" CRLF);
-					szDefinition += "\t\t}" CRLF;
-					szDefinition += "\t\tszValue +=\"\\\"\";" CRLF;
-					szDefinition += "\t}" CRLF;
-				}else{
-					QString szVariableName = "_" + ModelUtils::getUncapitalizedName(pAttribute->getName());
-					szDefinition += "\tif(!" + szVariableName + ".isNull()) {" CRLF;
-					szDefinition += "\t\tszValue += \" " + pAttribute->getName() + "=\\\"\" + " + szVariableName + ".serialize() + \"\\\"\";" CRLF;
-					szDefinition += "\t}" CRLF;
-				}
+		if(!pAttribute->getType()){
+			continue;
+		}
+
+		if(pAttribute->getType()->getTypeMode() == Type::TypeSimple) {
+			SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pAttribute->getType());
+			if(pAttribute->isList()){
+				szIterator = "iter_" + QString::number(iIteratorCount++);
+				writer << "if(" << pAttribute->getVariableNameList() << ".size() > 0) " << CodeWriter::BeginBlock;
+				writer << "buffer += \" " << pAttribute->getName() << "=\\\"\";" << CodeWriter::EndLine;
+				writer << "QList<" << pSimpleType->getCPPTypeNameString() << ">::const_iterator " << szIterator << ";" << CodeWriter::EndLine;
+				writer << "for(" << szIterator << " = " << pAttribute->getVariableNameList() << ".constBegin(); " << szIterator << " != " << pAttribute->getVariableNameList() << ".constEnd(); ++" << szIterator << ") " << CodeWriter::BeginBlock;
+				writer << "if(!" << szIterator << "->isNull()) " << CodeWriter::BeginBlock;
+				writer << "buffer += " << szIterator << "->serialize().toUtf8();" << CodeWriter::EndLine;
+				writer << "buffer += ' ';" << CodeWriter::EndLine;
+				writer << CodeWriter::EndBlock;
+				writer << CodeWriter::EndBlock;
+				writer << "buffer += '\"';" << CodeWriter::EndLine;
+				writer << CodeWriter::EndBlock;
+			}else{
+				writer << "if(!" << pSimpleType->getVariableName() << ".isNull()) " << CodeWriter::BeginBlock;
+				writer << "buffer += \" " << pAttribute->getName() << "=\\\"\";" << CodeWriter::EndLine;
+				writer << "buffer += " << pSimpleType->getVariableName() << ".serialize().toUtf8();" << CodeWriter::EndLine;
+				writer << "buffer += '\"';" << CodeWriter::EndLine;
+				writer << CodeWriter::EndBlock;
+			}
+		}else if(pAttribute->getType()->getTypeMode() == Type::TypeComplex){
+			ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(pAttribute->getType());
+			if(pAttribute->isList()){
+				szIterator = "iter_" + QString::number(iIteratorCount++);
+				writer << "if(" << pAttribute->getVariableNameList() << ".size() > 0) " << CodeWriter::BeginBlock;
+				writer << "buffer += \" " << pAttribute->getName() << "=\\\"\";" << CodeWriter::EndLine;
+				writer << "QList<" << pComplexType->getNameWithNamespace() << ">::const_iterator " << szIterator << ";" << CodeWriter::EndLine;
+				writer << "for(" << szIterator << " = " << pAttribute->getVariableNameList() << ".constBegin(); " << szIterator << " != " << pAttribute->getVariableNameList() << ".constEnd(); ++" << szIterator << ") " << CodeWriter::BeginBlock;
+				writer << "if(!" << szIterator << "->isNull()) " << CodeWriter::BeginBlock;
+				writer << "buffer += " << szIterator << "->serialize().toUtf8();" << CodeWriter::EndLine;
+				writer << "buffer += ' ';" << CodeWriter::EndLine;
+				writer << CodeWriter::EndBlock;
+				writer << CodeWriter::EndBlock;
+				writer << "buffer += '\"';" << CodeWriter::EndLine;
+				writer << CodeWriter::EndBlock;
+			}else{
+				QString szVariableName = "_" + ModelUtils::getUncapitalizedName(pAttribute->getName());
+				writer << "if(!" << szVariableName << ".isNull()) " << CodeWriter::BeginBlock;
+				writer << "buffer += \" " << pAttribute->getName() << "=\\\"\";" << CodeWriter::EndLine;
+				writer << "buffer += " << szVariableName << ".serialize().toUtf8();" << CodeWriter::EndLine;
+				writer << "buffer += '\"';" << CodeWriter::EndLine;
+				writer << CodeWriter::EndBlock;
 			}
 		}
 	}
@@ -1073,22 +1098,25 @@ QString ComplexType::getSerializerDefinition(const QString& szClassname, const Q
 
 		if(isExtensionTypeList()){
 			szIterator = "iter_" + QString::number(iIteratorCount++);
-			szDefinition += "\tQList<" + szExtensionName + ">::const_iterator " + szIterator + " = constBegin();" CRLF;
-			szDefinition += "\twhile(" + szIterator + " != constEnd()){" CRLF;
-			szDefinition += "\t\tszValue += (*" + szIterator + ").serialize(" +
-					QString(((getExtensionType()->getTypeMode() == Type::TypeSimple) ? "" : "true")) +
-					") + \" \";" CRLF;
-			szDefinition += "\t\t++" + szIterator + ";" CRLF;
-			szDefinition += "\t}" CRLF;
+			writer << "QList<" << szExtensionName << ">::const_iterator " << szIterator << " = constBegin();" << CodeWriter::EndLine;
+			writer << "while(" << szIterator << " != constEnd())" << CodeWriter::BeginBlock;
+			if(getExtensionType()->getTypeMode() == Type::TypeSimple){
+				writer << "buffer += (*" << szIterator << ").serialize().toUtf8();" << CodeWriter::EndLine;
+			}else{
+				writer << "(*" << szIterator << ").serialize(buffer, true);" << CodeWriter::EndLine;
+			}
+			writer << "buffer += ' ';" << CodeWriter::EndLine;
+			writer << "++" << szIterator << ";" << CodeWriter::EndLine;
+			writer << CodeWriter::EndBlock;
 		}else{
-			szDefinition += "\tszValue += " +
-					szExtensionName +
-					"::serialize(" +
-					((getExtensionType()->getTypeMode() == Type::TypeSimple) ? "" : "true") +
-					");" CRLF;
+			if(getExtensionType()->getTypeMode() == Type::TypeSimple){
+				writer << "buffer += " << szExtensionName << "::serialize().toUtf8();" << CodeWriter::EndLine;
+			}else{
+				writer << szExtensionName << "::serialize(buffer, true);" << CodeWriter::EndLine;
+			}
 		}
 	}else{
-		szDefinition += "\t\tszValue += \">\";" CRLF;
+		writer << "buffer += '>';" << CodeWriter::EndLine;
 	}
 
 	for(elem = m_pListElement->constBegin(); elem != m_pListElement->constEnd(); ++elem) {
@@ -1102,25 +1130,32 @@ QString ComplexType::getSerializerDefinition(const QString& szClassname, const Q
 			continue;
 		}
 
+		QString szStartTag = "<" + szNamespace + ":" + pElement->getName();
+		QString szEndTag = "</" + szNamespace + ":" + pElement->getName() + ">";
+
 		if(pElement->getType()->getTypeMode() == Type::TypeSimple) {
 			SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pElement->getType());
 
 			if(pElement->getMaxOccurs() > 1 || pElement->getMaxOccurs() == -1) {
 				szIterator = "iter_" + QString::number(iIteratorCount++);
 				if(pSimpleType->isEnumeration()){
-					szDefinition += QString("\tQList<%0>::const_iterator %1;" CRLF).arg(pSimpleType->getNameWithNamespace()).arg(szIterator);
+					writer << "QList<" << pSimpleType->getNameWithNamespace() << ">::const_iterator " << szIterator << ";" << CodeWriter::EndLine;
 				}else{
-					szDefinition += QString("\tQList<%0>::const_iterator %1;" CRLF).arg(pSimpleType->getCPPTypeNameString()).arg(szIterator);
+					writer << "QList<" << pSimpleType->getCPPTypeNameString() << ">::const_iterator " << szIterator << ";" << CodeWriter::EndLine;
 				}
-				szDefinition += QString("\tfor(%0 = %1List.constBegin(); %0 != %1List.constEnd(); ++%0) {" CRLF).arg(szIterator).arg(pElement->getVariableName());
-				szDefinition += QString("\t\tif(!%0->isNull()) {" CRLF).arg(szIterator);
-				szDefinition += QString("\t\t\tszValue += \"<" + szNamespace + ":" + pElement->getName() + ">\" + %0->serialize() + \"</" + szNamespace + ":" + pElement->getName() + ">\";" CRLF).arg(szIterator);
-				szDefinition += QString("\t\t}" CRLF);
-				szDefinition += "\t}" CRLF;
+				writer << "for(" << szIterator << " = " << pElement->getVariableNameList() << ".constBegin(); " << szIterator << " != " << pElement->getVariableNameList() << ".constEnd(); ++" << szIterator << ") " << CodeWriter::BeginBlock;
+				writer << "if(!" << szIterator << "->isNull()) " << CodeWriter::BeginBlock;
+				writer << "buffer += \"" << szStartTag << ">\";" << CodeWriter::EndLine;
+				writer << "buffer += " << szIterator << "->serialize().toUtf8();" << CodeWriter::EndLine;
+				writer << "buffer += \"" << szEndTag << "\";" << CodeWriter::EndLine;
+				writer << CodeWriter::EndBlock;
+				writer << CodeWriter::EndBlock;
 			} else{
-				szDefinition += "\tif(!" + pElement->getVariableName() + ".isNull()) {" CRLF;
-				szDefinition += "\t\tszValue += \"<" + szNamespace + ":" + pElement->getName() + ">\" + " + pElement->getVariableName() + ".serialize() + \"</" + szNamespace + ":" + pElement->getName() + ">\";" CRLF;
-				szDefinition += "\t}" CRLF;
+				writer << "if(!" << pElement->getVariableName() << ".isNull()) " << CodeWriter::BeginBlock;
+				writer << "buffer += \"" << szStartTag << ">\";" << CodeWriter::EndLine;
+				writer << "buffer += " << pElement->getVariableName() << ".serialize().toUtf8();" << CodeWriter::EndLine;
+				writer << "buffer += \"" << szEndTag << "\";" << CodeWriter::EndLine;
+				writer << CodeWriter::EndBlock;
 			}
 
 		}else if(pElement->getType()->getTypeMode() == Type::TypeComplex) {
@@ -1129,49 +1164,52 @@ QString ComplexType::getSerializerDefinition(const QString& szClassname, const Q
 			if(pElement->getMaxOccurs() > 1 || pElement->getMaxOccurs() == -1) {
 				szIterator = "iter_" + QString::number(iIteratorCount++);
 				if(pElement->isPointer()){
-					szDefinition += QString("\tQList<%0*>::const_iterator %1;" CRLF).arg( pComplexType->getNameWithNamespace()).arg(szIterator);
-					szDefinition += QString("\tfor(%0 = %1List.constBegin(); %0 != %1List.constEnd(); ++%0) {" CRLF).arg(szIterator).arg(pElement->getVariableName());
-					szDefinition += QString("\t\tif(*%0 && !(*%0)->isNull()) {" CRLF).arg(szIterator);
-					szDefinition += QString("\t\t\tszValue += (*%0)->serialize();" CRLF).arg(szIterator);
-					szDefinition += QString("\t\t}" CRLF);
-					szDefinition += "\t}" CRLF;
+					writer << "QList<" << pComplexType->getNameWithNamespace() << "*>::const_iterator " << szIterator << ";" << CodeWriter::EndLine;
+					writer << "for(" << szIterator << " = " << pElement->getVariableNameList() << ".constBegin(); " << szIterator << " != " << pElement->getVariableNameList() << ".constEnd(); ++" << szIterator << ") " << CodeWriter::BeginBlock;
+					writer << "if(*" << szIterator << " && !(*" << szIterator << ")->isNull()) " << CodeWriter::BeginBlock;
+					writer << "(*" << szIterator << ")->serialize(buffer);" << CodeWriter::EndLine;
+					writer << CodeWriter::EndBlock;
+					writer << CodeWriter::EndBlock;
 				}else{
-					szDefinition += QString("\tQList<%0>::const_iterator %1;" CRLF).arg( pComplexType->getNameWithNamespace()).arg(szIterator);
-					szDefinition += QString("\tfor(%0 = %1List.constBegin(); %0 != %1List.constEnd(); ++%0) {" CRLF).arg(szIterator).arg(pElement->getVariableName());
-					szDefinition += QString("\t\tif(!%0->isNull()) {" CRLF).arg(szIterator);
-					szDefinition += QString("\t\t\tszValue += \"<%0:%1\";" CRLF).arg(szNamespace).arg(pElement->getName());
-					szDefinition += QString("\t\t\tszValue += %0->serialize(true);" CRLF).arg(szIterator);
-					szDefinition += QString("\t\t\tszValue += \"</%0:%1>\";" CRLF).arg(szNamespace).arg(pElement->getName());
-					szDefinition += QString("\t\t}" CRLF);
-					szDefinition += "\t}" CRLF;
+					writer << "QList<" << pComplexType->getNameWithNamespace() << ">::const_iterator " << szIterator << ";" << CodeWriter::EndLine;
+					writer << "for(" << szIterator << " = " << pElement->getVariableNameList() << ".constBegin(); " << szIterator << " != " << pElement->getVariableNameList() << ".constEnd(); ++" << szIterator << ") " << CodeWriter::BeginBlock;
+					writer << "if(!" << szIterator << "->isNull()) " << CodeWriter::BeginBlock;
+					writer << "buffer += \"" << szStartTag << "\";" << CodeWriter::EndLine;
+					writer << szIterator << "->serialize(buffer, true);" << CodeWriter::EndLine;
+					writer << "buffer += \"" << szEndTag << "\";" << CodeWriter::EndLine;
+					writer << CodeWriter::EndBlock;
+					writer << CodeWriter::EndBlock;
 				}
 			} else{
-				szDefinition += "\tif(" + ((pElement->isNested() || pElement->isPointer()) ? pElement->getVariableName() + " && " : "") +
-						"!" + pElement->getVariableName() + ((pElement->isNested() || pElement->isPointer()) ? "->" : ".") + "isNull()) {" CRLF;
-				szDefinition += "\t\tszValue += \"<" + szNamespace + ":" + pElement->getName() + "\" + " + pElement->getVariableName() + ((pElement->isNested() || pElement->isPointer()) ? "->" : ".") + "serialize(true) + \"</" + szNamespace + ":" + pElement->getName() + ">\";" CRLF;
-				szDefinition += "\t}" CRLF;
+				bool bIsPointer = (pElement->isNested() || pElement->isPointer());
+				const char* szAccess = (bIsPointer ? "->" : ".");
+				writer << "if(";
+				if(bIsPointer){
+					writer << pElement->getVariableName() << " && ";
+				}
+				writer << "!" << pElement->getVariableName() << szAccess << "isNull()) " << CodeWriter::BeginBlock;
+				writer << "buffer += \"" << szStartTag << "\";" << CodeWriter::EndLine;
+				writer << pElement->getVariableName() << szAccess << "serialize(buffer, true);" << CodeWriter::EndLine;
+				writer << "buffer += \"" << szEndTag << "\";" << CodeWriter::EndLine;
+				writer << CodeWriter::EndBlock;
 			}
 		}
 	}
-	szDefinition += "\tif(!bOnlyContent) {" CRLF;
-	szDefinition += "\t\tszValue += \"</%1:%2>\";" CRLF;
-	szDefinition += "\t}" CRLF;
-	szDefinition += "\treturn szValue;" CRLF;
-	szDefinition += "}" CRLF;
-
-	return szDefinition.arg(szClassname).arg(szNamespace).arg(getLocalName());
+	writer << "if(!bOnlyContent) " << CodeWriter::BeginBlock;
+	writer << "buffer += \"</" << szNamespace << ":" << getLocalName() << ">\";" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndBlock;
 }
 
-QString ComplexType::getDeserializerDefinition(const QString& szClassname) const
+void ComplexType::writeDeserializerDefinition(CodeWriter& writer, const QString& szClassname) const
 {
 	AttributeList::const_iterator attr;
 	ElementList::const_iterator elem;
 	AttributeSharedPtr pAttribute;
 	ElementSharedPtr pElement;
 
-	QString szDefinition = ""
-	"void %0::deserialize(QDomElement& element)" CRLF
-	"{" CRLF;
+	writer << "void " << szClassname << "::deserialize(QDomElement& element)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
 
 	if(!getExtensionType().isNull()) {
 		QString szExtensionName;
@@ -1183,17 +1221,17 @@ QString ComplexType::getDeserializerDefinition(const QString& szClassname) const
 		}
 
 		if(isExtensionTypeList()){
-			szDefinition += "\tQString szElement = element.text();" CRLF;
-			szDefinition += "\tQStringList listElements = szElement.split(\" \");" CRLF;
-			szDefinition += "\tfor(int i = 0; i < listElements.size(); ++i){" CRLF;
-			szDefinition += "\t\tQDomAttr attr;" CRLF;
-			szDefinition += "\t\tattr.setValue(listElements[i]);" CRLF;
-			szDefinition += "\t\t" + szExtensionName + " item;" CRLF;
-			szDefinition += "\t\titem.deserialize(attr);" CRLF;
-			szDefinition += "\t\tappend(item);" CRLF;
-			szDefinition += "\t}" CRLF;
+			writer << "QString szElement = element.text();" << CodeWriter::EndLine;
+			writer << "QStringList listElements = szElement.split(\" \");" << CodeWriter::EndLine;
+			writer << "for(int i = 0; i < listElements.size(); ++i)" << CodeWriter::BeginBlock;
+			writer << "QDomAttr attr;" << CodeWriter::EndLine;
+			writer << "attr.setValue(listElements[i]);" << CodeWriter::EndLine;
+			writer << szExtensionName << " item;" << CodeWriter::EndLine;
+			writer << "item.deserialize(attr);" << CodeWriter::EndLine;
+			writer << "append(item);" << CodeWriter::EndLine;
+			writer << CodeWriter::EndBlock;
 		}else{
-			szDefinition += "\t" + szExtensionName + "::deserialize(element);" CRLF;
+			writer << szExtensionName << "::deserialize(element);" << CodeWriter::EndLine;
 		}
 	}
 
@@ -1207,31 +1245,29 @@ QString ComplexType::getDeserializerDefinition(const QString& szClassname) const
 
 		if( pAttribute->getType() && pAttribute->getType()->getTypeMode() == Type::TypeSimple) {
 			SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pAttribute->getType());
+			writer << "if(!element.attributeNode(\"" << pAttribute->getName() << "\").isNull()) " << CodeWriter::BeginBlock;
 			if(pAttribute->isList()){
-				szDefinition += "\tif(!element.attributeNode(\"" + pAttribute->getName() + "\").isNull()) {" CRLF;
-				szDefinition += "\t\tQDomAttr attribute = element.attributeNode(\"" + pAttribute->getName() + "\");" CRLF;
-				szDefinition += "\t\tQString szAttrValue = attribute.value();" CRLF;
-				szDefinition += "\t\tif(!szAttrValue.isEmpty()){" CRLF;
-				szDefinition += "\t\t\tQStringList szValues = szAttrValue.split(\" \");" CRLF;
-				szDefinition += "\t\t\tfor(int i = 0; i < szValues.size(); ++i){" CRLF;
-				szDefinition += "\t\t\t\tif(!szValues[i].isEmpty()){" CRLF;
-				szDefinition += "\t\t\t\t\t" + pSimpleType->getCPPTypeNameString() + " tmp;" CRLF;
-				szDefinition += "\t\t\t\t\ttmp.setValue(szValues[i]);" CRLF;
-				szDefinition += "\t\t\t\t\tadd" + ModelUtils::getCapitalizedName(pAttribute->getName()) + "(tmp);" CRLF;
-				szDefinition += "\t\t\t\t}" CRLF;
-				szDefinition += "\t\t\t}" CRLF;
-				szDefinition += "\t\t}" CRLF;
-				szDefinition += "\t}" CRLF;
+				writer << "QDomAttr attribute = element.attributeNode(\"" << pAttribute->getName() << "\");" << CodeWriter::EndLine;
+				writer << "QString szAttrValue = attribute.value();" << CodeWriter::EndLine;
+				writer << "if(!szAttrValue.isEmpty())" << CodeWriter::BeginBlock;
+				writer << "QStringList szValues = szAttrValue.split(\" \");" << CodeWriter::EndLine;
+				writer << "for(int i = 0; i < szValues.size(); ++i)" << CodeWriter::BeginBlock;
+				writer << "if(!szValues[i].isEmpty())" << CodeWriter::BeginBlock;
+				writer << pSimpleType->getCPPTypeNameString() << " tmp;" << CodeWriter::EndLine;
+				writer << "tmp.setValue(szValues[i]);" << CodeWriter::EndLine;
+				writer << "add" << ModelUtils::getCapitalizedName(pAttribute->getName()) << "(tmp);" << CodeWriter::EndLine;
+				writer << CodeWriter::EndBlock;
+				writer << CodeWriter::EndBlock;
+				writer << CodeWriter::EndBlock;
 			}else{
-				szDefinition += "\tif(!element.attributeNode(\"" + pAttribute->getName() + "\").isNull()) {" CRLF;
-				szDefinition += "\t\t" + pSimpleType->getVariableName() + ".deserialize(element.attributeNode(\"" + pAttribute->getName() + "\"));" CRLF;
-				szDefinition += "\t}" CRLF;
+				writer << pSimpleType->getVariableName() << ".deserialize(element.attributeNode(\"" << pAttribute->getName() << "\"));" << CodeWriter::EndLine;
 			}
+			writer << CodeWriter::EndBlock;
 		}
 	}
-	szDefinition += CRLF;
-	szDefinition += "\tQDomElement child = element.firstChild().toElement();" CRLF;
-	szDefinition += "\twhile(!child.isNull()) {" CRLF;
+	writer << CodeWriter::EndLine;
+	writer << "QDomElement child = element.firstChild().toElement();" << CodeWriter::EndLine;
+	writer << "while(!child.isNull()) " << CodeWriter::BeginBlock;
 	for(elem = m_pListElement->constBegin(); elem != m_pListElement->constEnd(); ++elem) {
 		if((*elem)->hasRef()){
 			pElement = (*elem)->getRef();
@@ -1247,22 +1283,22 @@ QString ComplexType::getDeserializerDefinition(const QString& szClassname) const
 			SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pElement->getType());
 
 			if(pElement->getMaxOccurs() > 1 || pElement->getMaxOccurs() == -1) {
-				szDefinition += "\t\tif(child.tagName() == \"" + getNamespace() + ":" + pElement->getName() + "\") {" CRLF;
+				writer << "if(child.tagName() == \"" << getNamespace() << ":" << pElement->getName() << "\") " << CodeWriter::BeginBlock;
 				if(pSimpleType->isEnumeration()){
-					szDefinition += "\t\t\t" + pSimpleType->getNameWithNamespace() + " item;" CRLF;
+					writer << pSimpleType->getNameWithNamespace() << " item;" << CodeWriter::EndLine;
 				}else{
-					szDefinition += "\t\t\t" + pSimpleType->getCPPTypeNameString() + " item;" CRLF;
+					writer << pSimpleType->getCPPTypeNameString() << " item;" << CodeWriter::EndLine;
 				}
-				szDefinition += "\t\t\titem.deserialize(child);" CRLF;
-				szDefinition += "\t\t\t" + pElement->getVariableName() + "List.append(item);" CRLF;
-				szDefinition += "\t\t}" CRLF;
+				writer << "item.deserialize(child);" << CodeWriter::EndLine;
+				writer << pElement->getVariableNameList() << ".append(item);" << CodeWriter::EndLine;
+				writer << CodeWriter::EndBlock;
 
 			} else{
-				szDefinition += "\t\tif((child.tagName() == \"" + getNamespace() + ":" + pElement->getName() + "\")" +
-						" || (child.tagName().endsWith(\":" + pElement->getName() + "\"" + "))"
-						" || (child.tagName() == \"" + pElement->getName() + "\"" + ")){" CRLF;
-				szDefinition += "\t\t\t" + pElement->getVariableName() + ".deserialize(child);" CRLF;
-				szDefinition += "\t\t}" CRLF;
+				writer << "if((child.tagName() == \"" << getNamespace() << ":" << pElement->getName() << "\")"
+						<< " || (child.tagName().endsWith(\":" << pElement->getName() << "\"))"
+						<< " || (child.tagName() == \"" << pElement->getName() << "\"))" << CodeWriter::BeginBlock;
+				writer << pElement->getVariableName() << ".deserialize(child);" << CodeWriter::EndLine;
+				writer << CodeWriter::EndBlock;
 			}
 
 		}else if(pElement->getType()->getTypeMode() == Type::TypeComplex) {
@@ -1270,68 +1306,93 @@ QString ComplexType::getDeserializerDefinition(const QString& szClassname) const
 
 			if(pElement->getMaxOccurs() > 1 || pElement->getMaxOccurs() == -1) {
 				if(pElement->isPointer()){
-					szDefinition += "\t\tif(child.tagName() == \"" + pComplexType->getNamespace() + ":" + pElement->getName() + "\") {" CRLF;
-					szDefinition += "\t\t\t" + pComplexType->getNameWithNamespace() + "* item = new " + pComplexType->getNameWithNamespace() + "();" CRLF;
-					szDefinition += "\t\t\titem->deserialize(child);" CRLF;
-					szDefinition += "\t\t\t" + pElement->getVariableName() + "List.append(item);" CRLF;
-					szDefinition += "\t\t}" CRLF;
+					writer << "if(child.tagName() == \"" << pComplexType->getNamespace() << ":" << pElement->getName() << "\") " << CodeWriter::BeginBlock;
+					writer << pComplexType->getNameWithNamespace() << "* item = new " << pComplexType->getNameWithNamespace() << "();" << CodeWriter::EndLine;
+					writer << "item->deserialize(child);" << CodeWriter::EndLine;
+					writer << pElement->getVariableNameList() << ".append(item);" << CodeWriter::EndLine;
+					writer << CodeWriter::EndBlock;
 				}else{
-					szDefinition += "\t\tif((child.tagName() == \"" + pComplexType->getNamespace() + ":" + pElement->getName() + "\") " +
-							" || child.tagName().endsWith(\":" + pElement->getName() + "\"" + ")){" CRLF;
-					szDefinition += "\t\t\t" + pComplexType->getNameWithNamespace() + " item;" CRLF;
-					szDefinition += "\t\t\titem.deserialize(child);" CRLF;
-					szDefinition += "\t\t\t" + pElement->getVariableName() + "List.append(item);" CRLF;
-					szDefinition += "\t\t}" CRLF;
+					writer << "if((child.tagName() == \"" << pComplexType->getNamespace() << ":" << pElement->getName() << "\") "
+							<< " || child.tagName().endsWith(\":" << pElement->getName() << "\"))" << CodeWriter::BeginBlock;
+					writer << pComplexType->getNameWithNamespace() << " item;" << CodeWriter::EndLine;
+					writer << "item.deserialize(child);" << CodeWriter::EndLine;
+					writer << pElement->getVariableNameList() << ".append(item);" << CodeWriter::EndLine;
+					writer << CodeWriter::EndBlock;
 				}
 			} else{
-				szDefinition += "\t\tif((child.tagName() == \"" + pComplexType->getNamespace() + ":" + pElement->getName() + "\") " +
-						" || child.tagName().endsWith(\":" + pElement->getName() + "\"" + ")){" CRLF;
-				if((pElement->isNested() || pElement->isPointer())){
-					szDefinition += "\t\t\tif(!" + pElement->getVariableName() + "){" CRLF;
-					szDefinition += "\t\t\t\t" + pElement->getVariableName() + " = new " + pElement->getType()->getLocalName() + "();" CRLF;
-					szDefinition += "\t\t\t}" CRLF;
+				bool bIsPointer = (pElement->isNested() || pElement->isPointer());
+				writer << "if((child.tagName() == \"" << pComplexType->getNamespace() << ":" << pElement->getName() << "\") "
+						<< " || child.tagName().endsWith(\":" << pElement->getName() << "\"))" << CodeWriter::BeginBlock;
+				if(bIsPointer){
+					writer << "if(!" << pElement->getVariableName() << ")" << CodeWriter::BeginBlock;
+					writer << pElement->getVariableName() << " = new " << pElement->getType()->getLocalName() << "();" << CodeWriter::EndLine;
+					writer << CodeWriter::EndBlock;
 				}
-				szDefinition += "\t\t\t" + pElement->getVariableName() + ((pElement->isNested() || pElement->isPointer()) ? "->" : ".") + "deserialize(child);" CRLF;
-				szDefinition += "\t\t}" CRLF;
+				writer << pElement->getVariableName() << (bIsPointer ? "->" : ".") << "deserialize(child);" << CodeWriter::EndLine;
+				writer << CodeWriter::EndBlock;
 			}
 		}
 	}
-	szDefinition += "\t\tchild = child.nextSibling().toElement();" CRLF;
-	szDefinition += "\t}" CRLF;
-	szDefinition += "}" CRLF;
-
-	return szDefinition.arg(szClassname);
+	writer << "child = child.nextSibling().toElement();" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndBlock;
 }
 
-QString ComplexType::getIsNullDefinition(const QString& szClassname) const
+void ComplexType::writeStreamDeserializerDefinition(CodeWriter& writer, const QString& szClassname) const
 {
 	AttributeList::const_iterator attr;
 	ElementList::const_iterator elem;
 	AttributeSharedPtr pAttribute;
 	ElementSharedPtr pElement;
 
-	QString szDefinition = ""
-	"bool %0::isNull() const" CRLF
-	"{" CRLF
-	"\treturn ";
-	QString szCond = "";
-
+	QString szExtensionName;
+	bool bIsComplexExtension = false;
 	if(!getExtensionType().isNull()) {
-		QString szExtensionName;
 		if(getExtensionType()->getTypeMode() == Type::TypeSimple){
 			SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(getExtensionType());
 			szExtensionName = pSimpleType->getCPPTypeNameString();
 		}else{
 			szExtensionName = getExtensionType()->getNameWithNamespace();
+			bIsComplexExtension = true;
 		}
+	}
 
+	// The reader is positioned on the start element and is left on its end element
+	writer << "void " << szClassname << "::deserialize(QXmlStreamReader& reader)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "deserializeAttributes(reader.attributes());" << CodeWriter::EndLine;
+	writer << CodeWriter::EndLine;
+	if(!szExtensionName.isEmpty() && !bIsComplexExtension) {
 		if(isExtensionTypeList()){
-			szCond += "isEmpty() && ";
+			writer << "QString szElement = reader.readElementText();" << CodeWriter::EndLine;
+			writer << "QStringList listElements = szElement.split(\" \");" << CodeWriter::EndLine;
+			writer << "for(int i = 0; i < listElements.size(); ++i)" << CodeWriter::BeginBlock;
+			writer << "QXmlStreamAttribute attr(QString(), listElements[i]);" << CodeWriter::EndLine;
+			writer << szExtensionName << " item;" << CodeWriter::EndLine;
+			writer << "item.deserialize(attr);" << CodeWriter::EndLine;
+			writer << "append(item);" << CodeWriter::EndLine;
+			writer << CodeWriter::EndBlock;
 		}else{
-			szCond += szExtensionName + "::isNull() && ";
+			writer << szExtensionName << "::deserialize(reader);" << CodeWriter::EndLine;
 		}
+	}else{
+		writer << "while(reader.readNextStartElement())" << CodeWriter::BeginBlock;
+		writer << "if(!deserializeElement(reader))" << CodeWriter::BeginBlock;
+		writer << "reader.skipCurrentElement();" << CodeWriter::EndLine;
+		writer << CodeWriter::EndBlock;
+		writer << CodeWriter::EndBlock;
 	}
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
 
+	writer << "void " << szClassname << "::deserializeAttributes(const QXmlStreamAttributes& attributes)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	if(bIsComplexExtension) {
+		writer << szExtensionName << "::deserializeAttributes(attributes);" << CodeWriter::EndLine;
+	}
+
+	//Not found other cases so we supposed attribute is only a simpleType
+	bool bHasAttribute = false;
 	for(attr = m_pListAttribute->constBegin(); attr != m_pListAttribute->constEnd(); ++attr) {
 		if((*attr)->hasRef()){
 			pAttribute = (*attr)->getRef();
@@ -1339,87 +1400,471 @@ QString ComplexType::getIsNullDefinition(const QString& szClassname) const
 			pAttribute = *attr;
 		}
 
-		if(pAttribute->getType()){
-			if( pAttribute->getType()->getTypeMode() == Type::TypeSimple) {
-				SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pAttribute->getType());
-				if(pAttribute->isList()){
-					szCond += "(_" + pAttribute->getName() + "List.size() > 0) && ";
-				}else{
-					szCond += pSimpleType->getVariableName() + ".isNull() && ";
-				}
+		if(!pAttribute->getType() || pAttribute->getType()->getTypeMode() != Type::TypeSimple) {
+			continue;
+		}
 
-			}else if( pAttribute->getType()->getTypeMode() == Type::TypeComplex) {
-				ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(pAttribute->getType());
-				if(pAttribute->isList()){
-					szCond += "(_" + pAttribute->getName() + "List.size() > 0) && ";
-				}else{
-					QString szVariableName = "_" + ModelUtils::getUncapitalizedName(pAttribute->getName());
-					szCond += szVariableName + ".isNull() && ";
-				}
-			}
+		if(!bHasAttribute) {
+			writer << "for(int i = 0; i < attributes.size(); ++i)" << CodeWriter::BeginBlock;
+			writer << "const QXmlStreamAttribute& attribute = attributes.at(i);" << CodeWriter::EndLine;
+			writer << "if(attribute.name() == QLatin1String(\"" << pAttribute->getName() << "\"))" << CodeWriter::BeginBlock;
+			bHasAttribute = true;
+		}else{
+			writer << CodeWriter::Unindent << "}else if(attribute.name() == QLatin1String(\"" << pAttribute->getName() << "\")){" << CodeWriter::EndLine << CodeWriter::Indent;
+		}
+
+		SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pAttribute->getType());
+		if(pAttribute->isList()){
+			writer << "QStringList szValues = attribute.value().toString().split(\" \");" << CodeWriter::EndLine;
+			writer << "for(int j = 0; j < szValues.size(); ++j)" << CodeWriter::BeginBlock;
+			writer << "if(!szValues[j].isEmpty())" << CodeWriter::BeginBlock;
+			writer << pSimpleType->getCPPTypeNameString() << " tmp;" << CodeWriter::EndLine;
+			writer << "tmp.setValue(szValues[j]);" << CodeWriter::EndLine;
+			writer << "add" << ModelUtils::getCapitalizedName(pAttribute->getName()) << "(tmp);" << CodeWriter::EndLine;
+			writer << CodeWriter::EndBlock;
+			writer << CodeWriter::EndBlock;
+		}else{
+			writer << pSimpleType->getVariableName() << ".deserialize(attribute);" << CodeWriter::EndLine;
 		}
 	}
+	if(bHasAttribute) {
+		writer << CodeWriter::EndBlock;
+		writer << CodeWriter::EndBlock;
+	}else if(!bIsComplexExtension) {
+		writer << "Q_UNUSED(attributes);" << CodeWriter::EndLine;
+	}
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+
+	// Children are dispatched on the hash of their local name, see NameHash.h in resources
+	QMap<quint32, QList<QPair<ElementSharedPtr, bool> > > mapElementsByHash;
+	bool bHasLocalElement = false;
 	for(elem = m_pListElement->constBegin(); elem != m_pListElement->constEnd(); ++elem) {
-		if((*elem)->hasRef()){
+		bool bIsRef = (*elem)->hasRef();
+		if(bIsRef){
 			pElement = (*elem)->getRef();
 		}else{
 			pElement = *elem;
 		}
 
-		if( !pElement->getType()) {
+		if(!pElement->getType()) {
 			continue;
 		}
-		if(pElement->getType()->getTypeMode() == Type::TypeSimple) {
-			SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pElement->getType());
-			if(pElement->getMaxOccurs() > 1 || pElement->getMaxOccurs() == -1) {
-				szCond += pElement->getVariableName() + "List.isEmpty() && ";
-			}else{
-				szCond += pElement->getVariableName() + ".isNull() && ";
-			}
 
-		}else if(pElement->getType()->getTypeMode() == Type::TypeComplex) {
-			ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(pElement->getType());
-			if(pElement->getMaxOccurs() > 1 || pElement->getMaxOccurs() == -1) {
-				szCond += pElement->getVariableName() + "List.isEmpty() && ";
-			}else{
-				if((pElement->isNested() || pElement->isPointer())){
-					szCond += "(!" + pElement->getVariableName() + " || (" + pElement->getVariableName() + " && " + pElement->getVariableName() + "->isNull())) && ";
-				}else{
-					szCond += pElement->getVariableName() + ".isNull() && ";
+		// Referenced elements are qualified with the namespace of their own schema, so it is not checked
+		if(!bIsRef && !getNamespaceUri().isEmpty()) {
+			bHasLocalElement = true;
+		}
+		mapElementsByHash[ModelUtils::getNameHash(pElement->getName())].append(qMakePair(pElement, !bIsRef));
+	}
+
+	writer << "bool " << szClassname << "::deserializeElement(QXmlStreamReader& reader)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	if(bHasLocalElement) {
+		// Local elements are either unqualified or in the target namespace
+		writer << "bool bLocalNamespace = (reader.namespaceUri().isEmpty() || reader.namespaceUri() == QLatin1String(\"" << getNamespaceUri() << "\"));" << CodeWriter::EndLine;
+	}
+	if(!mapElementsByHash.isEmpty()) {
+		QMap<quint32, QList<QPair<ElementSharedPtr, bool> > >::const_iterator iter;
+		writer << "switch(nameHash(reader.name()))" << CodeWriter::BeginBlock;
+		for(iter = mapElementsByHash.constBegin(); iter != mapElementsByHash.constEnd(); ++iter) {
+			writer << CodeWriter::Unindent << "case 0x" << QString::number(iter.key(), 16) << "U:" << CodeWriter::EndLine << CodeWriter::Indent;
+			for(int i = 0; i < iter.value().size(); ++i) {
+				const QPair<ElementSharedPtr, bool>& element = iter.value().at(i);
+				writer << "if(";
+				if(element.second && !getNamespaceUri().isEmpty()) {
+					writer << "bLocalNamespace && ";
 				}
+				writer << "reader.name() == QLatin1String(\"" << element.first->getName() << "\"))" << CodeWriter::BeginBlock;
+				writeStreamElementDeserializer(writer, element.first);
+				writer << "return true;" << CodeWriter::EndLine;
+				writer << CodeWriter::EndBlock;
 			}
+			writer << "break;" << CodeWriter::EndLine;
 		}
+		writer << CodeWriter::Unindent << "default:" << CodeWriter::EndLine << CodeWriter::Indent;
+		writer << "break;" << CodeWriter::EndLine;
+		writer << CodeWriter::EndBlock;
 	}
-	if(szCond.length() > 1) {
-		szDefinition += szCond.left(szCond.length() - 4);
-		szDefinition += ";" CRLF;
+	if(bIsComplexExtension) {
+		writer << "return " << szExtensionName << "::deserializeElement(reader);" << CodeWriter::EndLine;
 	}else{
-		szDefinition += "true;" CRLF;
+		if(mapElementsByHash.isEmpty()) {
+			writer << "Q_UNUSED(reader);" << CodeWriter::EndLine;
+		}
+		writer << "return false;" << CodeWriter::EndLine;
 	}
-	szDefinition += "}" CRLF;
+	writer << CodeWriter::EndBlock;
+}
 
-	return szDefinition.arg(szClassname);
+void ComplexType::writeStreamElementDeserializer(CodeWriter& writer, const ElementSharedPtr& pElement) const
+{
+	bool bIsList = (pElement->getMaxOccurs() > 1 || pElement->getMaxOccurs() == -1);
+
+	if(pElement->getType()->getTypeMode() == Type::TypeSimple) {
+		SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pElement->getType());
+
+		if(bIsList) {
+			if(pSimpleType->isEnumeration()){
+				writer << pSimpleType->getNameWithNamespace() << " item;" << CodeWriter::EndLine;
+			}else{
+				writer << pSimpleType->getCPPTypeNameString() << " item;" << CodeWriter::EndLine;
+			}
+			writer << "item.deserialize(reader);" << CodeWriter::EndLine;
+			writer << pElement->getVariableNameList() << ".append(item);" << CodeWriter::EndLine;
+		}else{
+			writer << pElement->getVariableName() << ".deserialize(reader);" << CodeWriter::EndLine;
+		}
+
+	}else if(pElement->getType()->getTypeMode() == Type::TypeComplex) {
+		ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(pElement->getType());
+
+		if(bIsList) {
+			if(pElement->isPointer()){
+				writer << pComplexType->getNameWithNamespace() << "* item = new " << pComplexType->getNameWithNamespace() << "();" << CodeWriter::EndLine;
+				writer << "item->deserialize(reader);" << CodeWriter::EndLine;
+			}else{
+				writer << pComplexType->getNameWithNamespace() << " item;" << CodeWriter::EndLine;
+				writer << "item.deserialize(reader);" << CodeWriter::EndLine;
+			}
+			writer << pElement->getVariableNameList() << ".append(item);" << CodeWriter::EndLine;
+		}else{
+			bool bIsPointer = (pElement->isNested() || pElement->isPointer());
+			if(bIsPointer){
+				writer << "if(!" << pElement->getVariableName() << ")" << CodeWriter::BeginBlock;
+				writer << pElement->getVariableName() << " = new " << pElement->getType()->getLocalName() << "();" << CodeWriter::EndLine;
+				writer << CodeWriter::EndBlock;
+			}
+			writer << pElement->getVariableName() << (bIsPointer ? "->" : ".") << "deserialize(reader);" << CodeWriter::EndLine;
+		}
+	}
 }
 
-QString ComplexType::getGetNamespaceDeclarationDefinition(const QString& szClassname) const
+void ComplexType::writeIsNullDefinition(CodeWriter& writer, const QString& szClassname) const
 {
 	AttributeList::const_iterator attr;
 	ElementList::const_iterator elem;
 	AttributeSharedPtr pAttribute;
 	ElementSharedPtr pElement;
 
-	QString szDefinition = ""
-	"QList<QString> %0::getNamespaceDeclaration()" CRLF
-	"{" CRLF;
-	szDefinition += "\tQList<QString> listNamespaceDeclaration;" CRLF;
+	QStringList listConditions;
 
-	if(!getExtensionType().isNull()){
+	if(!getExtensionType().isNull()) {
 		QString szExtensionName;
-		if(getExtensionType()->getTypeMode() == Type::TypeComplex){
-			szDefinition += "\tlistNamespaceDeclaration.append(" + getExtensionType()->getNameWithNamespace() + "::getNamespaceDeclaration());" CRLF;
+		if(getExtensionType()->getTypeMode() == Type::TypeSimple){
+			SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(getExtensionType());
+			szExtensionName = pSimpleType->getCPPTypeNameString();
+		}else{
+			szExtensionName = getExtensionType()->getNameWithNamespace();
+		}
+
+		if(isExtensionTypeList()){
+			listConditions.append("isEmpty()");
+		}else{
+			listConditions.append(szExtensionName + "::isNull()");
 		}
 	}
 
+	for(attr = m_pListAttribute->constBegin(); attr != m_pListAttribute->constEnd(); ++attr) {
+		if((*attr)->hasRef()){
+			pAttribute = (*attr)->getRef();
+		}else{
+			pAttribute = *attr;
+		}
+
+		if(!pAttribute->getType()){
+			continue;
+		}
+
+		if(pAttribute->isList()){
+			listConditions.append(pAttribute->getVariableNameList() + ".isEmpty()");
+		}else if(pAttribute->getType()->getTypeMode() == Type::TypeSimple) {
+			SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pAttribute->getType());
+			listConditions.append(pSimpleType->getVariableName() + ".isNull()");
+		}else if(pAttribute->getType()->getTypeMode() == Type::TypeComplex) {
+			listConditions.append("_" + ModelUtils::getUncapitalizedName(pAttribute->getName()) + ".isNull()");
+		}
+	}
+	for(elem = m_pListElement->constBegin(); elem != m_pListElement->constEnd(); ++elem) {
+		if((*elem)->hasRef()){
+			pElement = (*elem)->getRef();
+		}else{
+			pElement = *elem;
+		}
+
+		if( !pElement->getType()) {
+			continue;
+		}
+		if(pElement->getMaxOccurs() > 1 || pElement->getMaxOccurs() == -1) {
+			listConditions.append(pElement->getVariableNameList() + ".isEmpty()");
+		}else if(pElement->getType()->getTypeMode() == Type::TypeComplex && (pElement->isNested() || pElement->isPointer())) {
+			listConditions.append("(!" + pElement->getVariableName() + " || " + pElement->getVariableName() + "->isNull())");
+		}else{
+			listConditions.append(pElement->getVariableName() + ".isNull()");
+		}
+	}
+
+	writer << "bool " << szClassname << "::isNull() const" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	if(listConditions.isEmpty()) {
+		writer << "return true;" << CodeWriter::EndLine;
+	}else{
+		writer << "return " << listConditions.join(" && ") << ";" << CodeWriter::EndLine;
+	}
+	writer << CodeWriter::EndBlock;
+}
+
+void ComplexType::writeGetNamespaceDeclarationDefinition(CodeWriter& writer, const QString& szClassname) const
+{
+	// The transitive set is resolved here so the generated code only returns a shared constant
+	QStringList listNamespaceDeclaration = getNamespaceDeclarationList();
+
+	writer << "QList<QString> " << szClassname << "::getNamespaceDeclaration()" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "static const QList<QString> listNamespaceDeclaration = QList<QString>()" << CodeWriter::EndLine;
+	writer << CodeWriter::Indent;
+	for(int i = 0; i < listNamespaceDeclaration.size(); ++i){
+		writer << "<< QString(\"" << StringUtils::escapeString(listNamespaceDeclaration[i]) << "\")";
+		writer << (i == listNamespaceDeclaration.size() - 1 ? ";" : "") << CodeWriter::EndLine;
+	}
+	writer << CodeWriter::Unindent;
+	writer << "return listNamespaceDeclaration;" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+}
+
+void ComplexType::writeArenaOperatorsDefinition(CodeWriter& writer, const QString& szClassname) const
+{
+	// Allocations go to the ObjectArena active on the thread, if any
+	writer << "void* " << szClassname << "::operator new(size_t iSize)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "return ObjectArena::allocate(iSize, &ObjectArena::destroy<" << szClassname << ">);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+	writer << "void " << szClassname << "::operator delete(void* pObject)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "ObjectArena::release(pObject);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+}
+
+void ComplexType::writeLifecycleDefinition(CodeWriter& writer, const QString& szClassname, const QString& szBaseClassname) const
+{
+	QStringList listValueMembers;
+	QList<QPair<QString, QString> > listPointerMembers;
+	QList<QPair<QString, QString> > listPointerListMembers;
+	QList<QPair<QString, QString> >::const_iterator pointer;
+	getMemberList(listValueMembers, listPointerMembers, listPointerListMembers);
+
+	QStringList listCopyInit;
+	QStringList listMoveInit;
+	if(!szBaseClassname.isEmpty()){
+		listCopyInit.append(szBaseClassname + "(other)");
+		listMoveInit.append(szBaseClassname + "(std::move(other))");
+	}
+	QStringList::const_iterator member;
+	for(member = listValueMembers.constBegin(); member != listValueMembers.constEnd(); ++member) {
+		listCopyInit.append(*member + "(other." + *member + ")");
+		listMoveInit.append(*member + "(std::move(other." + *member + "))");
+	}
+
+	// Constructor and destructor, the pointer members are owned
+	writer << szClassname << "::" << szClassname << "()";
+	if(!szBaseClassname.isEmpty()){
+		writer << " : " << szBaseClassname << "()";
+	}
+	writer << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	for(pointer = listPointerMembers.constBegin(); pointer != listPointerMembers.constEnd(); ++pointer) {
+		writer << pointer->first << " = NULL;" << CodeWriter::EndLine;
+	}
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+
+	writer << szClassname << "::~" << szClassname << "()" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	for(pointer = listPointerMembers.constBegin(); pointer != listPointerMembers.constEnd(); ++pointer) {
+		writer << "if(" << pointer->first << ")" << CodeWriter::BeginBlock;
+		writer << "delete " << pointer->first << ";" << CodeWriter::EndLine;
+		writer << pointer->first << " = NULL;" << CodeWriter::EndLine;
+		writer << CodeWriter::EndBlock;
+	}
+	for(pointer = listPointerListMembers.constBegin(); pointer != listPointerListMembers.constEnd(); ++pointer) {
+		writer << "qDeleteAll(" << pointer->first << ");" << CodeWriter::EndLine;
+		writer << pointer->first << ".clear();" << CodeWriter::EndLine;
+	}
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+
+	// Copy makes a deep copy of the owned pointers
+	writer << szClassname << "::" << szClassname << "(const " << szClassname << "& other)" << CodeWriter::EndLine;
+	if(!listCopyInit.isEmpty()){
+		writer << CodeWriter::Indent << ": " << listCopyInit.join(", ") << CodeWriter::EndLine << CodeWriter::Unindent;
+	}
+	writer << CodeWriter::BeginBlock;
+	if(listCopyInit.isEmpty() && listPointerMembers.isEmpty() && listPointerListMembers.isEmpty()){
+		writer << "Q_UNUSED(other);" << CodeWriter::EndLine;
+	}
+	for(pointer = listPointerMembers.constBegin(); pointer != listPointerMembers.constEnd(); ++pointer) {
+		writer << pointer->first << " = (other." << pointer->first << " ? new " << pointer->second << "(*other." << pointer->first << ") : NULL);" << CodeWriter::EndLine;
+	}
+	for(pointer = listPointerListMembers.constBegin(); pointer != listPointerListMembers.constEnd(); ++pointer) {
+		writePointerListCopy(writer, pointer->first, pointer->second);
+	}
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+
+	writer << szClassname << "& " << szClassname << "::operator=(const " << szClassname << "& other)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "if(this != &other)" << CodeWriter::BeginBlock;
+	if(!szBaseClassname.isEmpty()){
+		writer << szBaseClassname << "::operator=(other);" << CodeWriter::EndLine;
+	}
+	for(member = listValueMembers.constBegin(); member != listValueMembers.constEnd(); ++member) {
+		writer << *member << " = other." << *member << ";" << CodeWriter::EndLine;
+	}
+	for(pointer = listPointerMembers.constBegin(); pointer != listPointerMembers.constEnd(); ++pointer) {
+		writer << "delete " << pointer->first << ";" << CodeWriter::EndLine;
+		writer << pointer->first << " = (other." << pointer->first << " ? new " << pointer->second << "(*other." << pointer->first << ") : NULL);" << CodeWriter::EndLine;
+	}
+	for(pointer = listPointerListMembers.constBegin(); pointer != listPointerListMembers.constEnd(); ++pointer) {
+		writer << "qDeleteAll(" << pointer->first << ");" << CodeWriter::EndLine;
+		writer << pointer->first << ".clear();" << CodeWriter::EndLine;
+		writePointerListCopy(writer, pointer->first, pointer->second);
+	}
+	writer << CodeWriter::EndBlock;
+	writer << "return *this;" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+
+	// Move steals the members and the owned pointers
+	writer << "#ifdef Q_COMPILER_RVALUE_REFS" << CodeWriter::EndLine;
+	writer << szClassname << "::" << szClassname << "(" << szClassname << "&& other)" << CodeWriter::EndLine;
+	if(!listMoveInit.isEmpty()){
+		writer << CodeWriter::Indent << ": " << listMoveInit.join(", ") << CodeWriter::EndLine << CodeWriter::Unindent;
+	}
+	writer << CodeWriter::BeginBlock;
+	if(listMoveInit.isEmpty() && listPointerMembers.isEmpty() && listPointerListMembers.isEmpty()){
+		writer << "Q_UNUSED(other);" << CodeWriter::EndLine;
+	}
+	for(pointer = listPointerMembers.constBegin(); pointer != listPointerMembers.constEnd(); ++pointer) {
+		writer << pointer->first << " = other." << pointer->first << ";" << CodeWriter::EndLine;
+		writer << "other." << pointer->first << " = NULL;" << CodeWriter::EndLine;
+	}
+	for(pointer = listPointerListMembers.constBegin(); pointer != listPointerListMembers.constEnd(); ++pointer) {
+		writer << pointer->first << ".swap(other." << pointer->first << ");" << CodeWriter::EndLine;
+	}
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+
+	writer << szClassname << "& " << szClassname << "::operator=(" << szClassname << "&& other)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "if(this != &other)" << CodeWriter::BeginBlock;
+	if(!szBaseClassname.isEmpty()){
+		writer << szBaseClassname << "::operator=(std::move(other));" << CodeWriter::EndLine;
+	}
+	for(member = listValueMembers.constBegin(); member != listValueMembers.constEnd(); ++member) {
+		writer << *member << " = std::move(other." << *member << ");" << CodeWriter::EndLine;
+	}
+	for(pointer = listPointerMembers.constBegin(); pointer != listPointerMembers.constEnd(); ++pointer) {
+		writer << "delete " << pointer->first << ";" << CodeWriter::EndLine;
+		writer << pointer->first << " = other." << pointer->first << ";" << CodeWriter::EndLine;
+		writer << "other." << pointer->first << " = NULL;" << CodeWriter::EndLine;
+	}
+	for(pointer = listPointerListMembers.constBegin(); pointer != listPointerListMembers.constEnd(); ++pointer) {
+		writer << "qDeleteAll(" << pointer->first << ");" << CodeWriter::EndLine;
+		writer << pointer->first << ".clear();" << CodeWriter::EndLine;
+		writer << pointer->first << ".swap(other." << pointer->first << ");" << CodeWriter::EndLine;
+	}
+	writer << CodeWriter::EndBlock;
+	writer << "return *this;" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << "#endif" << CodeWriter::EndLine;
+}
+
+void ComplexType::writePointerListCopy(CodeWriter& writer, const QString& szName, const QString& szType)
+{
+	writer << szName << ".reserve(other." << szName << ".size());" << CodeWriter::EndLine;
+	writer << "for(int i = 0; i < other." << szName << ".size(); ++i)" << CodeWriter::BeginBlock;
+	writer << szName << ".append(other." << szName << ".at(i) ? new " << szType << "(*other." << szName << ".at(i)) : NULL);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+}
+
+void ComplexType::getMemberList(QStringList& listValueMembers, QList<QPair<QString, QString> >& listPointerMembers,
+		QList<QPair<QString, QString> >& listPointerListMembers) const
+{
+	AttributeList::const_iterator attr;
+	AttributeSharedPtr pAttribute;
+	for(attr = m_pListAttribute->constBegin(); attr != m_pListAttribute->constEnd(); ++attr) {
+		if((*attr)->hasRef()){
+			pAttribute = (*attr)->getRef();
+		}else{
+			pAttribute = *attr;
+		}
+
+		if(!pAttribute->getType()) {
+			continue;
+		}
+
+		// Same names as in Attribute::writeVariableDeclaration()
+		if(pAttribute->isList()){
+			listValueMembers.append(pAttribute->getVariableNameList());
+		}else if(pAttribute->getType()->getTypeMode() == Type::TypeSimple){
+			listValueMembers.append(qSharedPointerCast<SimpleType>(pAttribute->getType())->getVariableName());
+		}else{
+			listValueMembers.append("_" + ModelUtils::getUncapitalizedName(pAttribute->getName()));
+		}
+	}
+
+	ElementList::const_iterator elem;
+	ElementSharedPtr pElement;
+	for(elem = m_pListElement->constBegin(); elem != m_pListElement->constEnd(); ++elem) {
+		if((*elem)->hasRef()){
+			pElement = (*elem)->getRef();
+		}else{
+			pElement = *elem;
+		}
+
+		if(!pElement->getType()) {
+			continue;
+		}
+
+		if(pElement->getMaxOccurs() > 1 || pElement->getMaxOccurs() == -1) {
+			// Same condition as the QList<T*> declaration
+			if(pElement->getType()->getTypeMode() == Type::TypeComplex && pElement->isPointer()) {
+				listPointerListMembers.append(qMakePair(pElement->getVariableNameList(), pElement->getType()->getNameWithNamespace()));
+			}else{
+				listValueMembers.append(pElement->getVariableNameList());
+			}
+		}else if(pElement->getType()->getTypeMode() == Type::TypeComplex && (pElement->isNested() || pElement->isPointer())) {
+			listPointerMembers.append(qMakePair(pElement->getVariableName(), pElement->getType()->getLocalName()));
+		}else{
+			listValueMembers.append(pElement->getVariableName());
+		}
+	}
+}
+
+QStringList ComplexType::getNamespaceDeclarationList() const
+{
+	QStringList listNamespaceDeclaration;
+	QSet<const ComplexType*> setVisitedTypes;
+	buildNamespaceDeclarationList(listNamespaceDeclaration, setVisitedTypes);
+	listNamespaceDeclaration.removeDuplicates();
+	return listNamespaceDeclaration;
+}
+
+void ComplexType::buildNamespaceDeclarationList(QStringList& listNamespaceDeclaration, QSet<const ComplexType*>& setVisitedTypes) const
+{
+	ElementList::const_iterator elem;
+	ElementSharedPtr pElement;
+
+	if(setVisitedTypes.contains(this)) {
+		return;
+	}
+	setVisitedTypes.insert(this);
+
+	if(!getExtensionType().isNull() && getExtensionType()->getTypeMode() == Type::TypeComplex){
+		qSharedPointerCast<ComplexType>(getExtensionType())->buildNamespaceDeclarationList(listNamespaceDeclaration, setVisitedTypes);
+	}
+
 	for(elem = m_pListElement->constBegin(); elem != m_pListElement->constEnd(); ++elem){
 		if((*elem)->hasRef()){
 			pElement = (*elem)->getRef();
@@ -1433,16 +1878,267 @@ QString ComplexType::getGetNamespaceDeclarationDefinition(const QString& szClass
 
 		if((pElement->getType()->getTypeMode() == Type::TypeComplex) &&
 				(getLocalName(true) != pElement->getType()->getLocalName(true))){
-			ComplexTypeSharedPtr pComplexType = qSharedPointerCast<ComplexType>(pElement->getType());
-			szDefinition += "\tlistNamespaceDeclaration.append(" + pComplexType->getNameWithNamespace() + "::getNamespaceDeclaration());" CRLF;
+			qSharedPointerCast<ComplexType>(pElement->getType())->buildNamespaceDeclarationList(listNamespaceDeclaration, setVisitedTypes);
 		}
 	}
 
-	szDefinition += "\tlistNamespaceDeclaration.append(\"xmlns:" + getNamespace() + "=\\\"" + getNamespaceUri() + "\\\"\");" CRLF;
-	szDefinition += "\treturn listNamespaceDeclaration;" CRLF;
-	szDefinition += "}" CRLF;
+	listNamespaceDeclaration.append("xmlns:" + getNamespace() + "=\"" + getNamespaceUri() + "\"");
+}
 
-	return szDefinition.arg(szClassname);
+bool ComplexType::isTableSerializable() const
+{
+	AttributeList::const_iterator attr;
+	AttributeSharedPtr pAttribute;
+
+	if(!getExtensionType().isNull() && isExtensionTypeList()) {
+		return false;
+	}
+
+	// Only single simple attributes are described in the tables
+	for(attr = m_pListAttribute->constBegin(); attr != m_pListAttribute->constEnd(); ++attr) {
+		if((*attr)->hasRef()){
+			pAttribute = (*attr)->getRef();
+		}else{
+			pAttribute = *attr;
+		}
+
+		if(!pAttribute->getType()) {
+			continue;
+		}
+		if(pAttribute->isList() || pAttribute->getType()->getTypeMode() != Type::TypeSimple) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+QString ComplexType::getTypeDescriptorDeclaration() const
+{
+	return "static const TypeDescriptor s_typeDescriptor;";
+}
+
+QString ComplexType::getFieldDescriptorDeclaration() const
+{
+	int iCount = getFieldDescriptorCount();
+	if(!isTableSerializable() || iCount == 0) {
+		return QString();
+	}
+	return "static const FieldDescriptor s_fieldDescriptors[" + QString::number(iCount) + "];";
+}
+
+void ComplexType::writeTableSerializerDefinition(CodeWriter& writer, const QString& szClassname) const
+{
+	writer << "QString " << szClassname << "::serialize(bool bOnlyContent) const" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "return TypeSerializer::serialize(s_typeDescriptor, this, bOnlyContent);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+	writer << "void " << szClassname << "::serialize(QByteArray& buffer, bool bOnlyContent) const" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "TypeSerializer::serialize(s_typeDescriptor, this, buffer, bOnlyContent);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+}
+
+void ComplexType::writeTableDeserializerDefinition(CodeWriter& writer, const QString& szClassname) const
+{
+	writer << "void " << szClassname << "::deserialize(QDomElement& element)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "TypeSerializer::deserialize(s_typeDescriptor, this, element);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;	writer << CodeWriter::EndLine;
+	writer << "void " << szClassname << "::deserialize(QXmlStreamReader& reader)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "TypeSerializer::deserialize(s_typeDescriptor, this, reader);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+	writer << "void " << szClassname << "::deserializeAttributes(const QXmlStreamAttributes& attributes)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "TypeSerializer::deserializeAttributes(s_typeDescriptor, this, attributes);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+	writer << "bool " << szClassname << "::deserializeElement(QXmlStreamReader& reader)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "return TypeSerializer::deserializeElement(s_typeDescriptor, this, reader);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+}
+
+void ComplexType::writeTypeDescriptorDefinition(CodeWriter& writer, const QString& szClassname, const QString& szNamespace) const
+{
+	AttributeList::const_iterator attr;
+	ElementList::const_iterator elem;
+	AttributeSharedPtr pAttribute;
+	ElementSharedPtr pElement;
+
+	QString szMemberType;
+	QString szAccessor;
+
+	QString szFields = "NULL";
+	int iCount = 0;
+
+	QString szBaseTypeDescriptor = "NULL";
+	QString szBaseValueDescriptor = "NULL";
+	QString szToConstBase = "NULL";
+	QString szToBase = "NULL";
+
+	QString szSerialize = "NULL";
+	QString szDeserialize = "NULL";
+	QString szRead = "NULL";
+	QString szReadAttributes = "NULL";
+	QString szReadElement = "NULL";
+
+	if(isTableSerializable()) {
+		iCount = getFieldDescriptorCount();
+		if(iCount > 0) {
+			szFields = "s_fieldDescriptors";
+			writer << "const FieldDescriptor " << szClassname << "::s_fieldDescriptors[" << iCount << "] = " << CodeWriter::BeginBlock;
+		}
+
+		for(attr = m_pListAttribute->constBegin(); attr != m_pListAttribute->constEnd(); ++attr) {
+			if((*attr)->hasRef()){
+				pAttribute = (*attr)->getRef();
+			}else{
+				pAttribute = *attr;
+			}
+
+			if(!pAttribute->getType()) {
+				continue;
+			}
+
+			SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pAttribute->getType());
+			szMemberType = pSimpleType->getCPPTypeNameString();
+			szAccessor = "MemberField<" + szClassname + ", " + szMemberType + ", &" + szClassname + "::" + pSimpleType->getVariableName() + ">";
+
+			writeFieldDescriptorDefinition(writer, pAttribute->getName(), QString(), "FieldDescriptor::FlagAttribute",
+					(pAttribute->isRequired() ? 1 : 0), 1,
+					"NULL", "&ValueTraits<" + szMemberType + ">::descriptor", szAccessor,
+					"&ValueTraits<" + szMemberType + ">::deserializeAttribute", "&ValueTraits<" + szMemberType + ">::readAttribute");
+		}
+
+		for(elem = m_pListElement->constBegin(); elem != m_pListElement->constEnd(); ++elem) {
+			if((*elem)->hasRef()){
+				pElement = (*elem)->getRef();
+			}else{
+				pElement = *elem;
+			}
+
+			if(!pElement->getType()) {
+				continue;
+			}
+
+			bool bIsList = (pElement->getMaxOccurs() > 1 || pElement->getMaxOccurs() == -1);
+			QString szFlags = "FieldDescriptor::FlagElement";
+			QString szTypeDescriptor = "NULL";
+			QString szValueDescriptor = "NULL";
+
+			// Member types must be written as in the declaration for the pointer to member to match
+			if(pElement->getType()->getTypeMode() == Type::TypeSimple) {
+				SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(pElement->getType());
+				szMemberType = pSimpleType->getCPPTypeNameString();
+				szValueDescriptor = "&ValueTraits<" + szMemberType + ">::descriptor";
+				if(bIsList) {
+					szAccessor = "ListField<" + szClassname + ", " + szMemberType + ", &" + szClassname + "::" + pElement->getVariableNameList() + ">";
+				}else{
+					szAccessor = "MemberField<" + szClassname + ", " + szMemberType + ", &" + szClassname + "::" + pElement->getVariableName() + ">";
+				}
+			}else{
+				if(bIsList) {
+					szMemberType = pElement->getType()->getNameWithNamespace();
+					if(pElement->isPointer()) {
+						szFlags = "FieldDescriptor::FlagSelfTagged";
+						szAccessor = "PointerListField<" + szClassname + ", " + szMemberType + ", &" + szClassname + "::" + pElement->getVariableNameList() + ">";
+					}else{
+						szAccessor = "ListField<" + szClassname + ", " + szMemberType + ", &" + szClassname + "::" + pElement->getVariableNameList() + ">";
+					}
+				}else if(pElement->isNested() || pElement->isPointer()) {
+					szMemberType = pElement->getType()->getLocalName();
+					szAccessor = "PointerField<" + szClassname + ", " + szMemberType + ", &" + szClassname + "::" + pElement->getVariableName() + ">";
+				}else{
+					szMemberType = pElement->getType()->getNameWithNamespace();
+					szAccessor = "MemberField<" + szClassname + ", " + szMemberType + ", &" + szClassname + "::" + pElement->getVariableName() + ">";
+				}
+				szTypeDescriptor = "&" + szMemberType + "::s_typeDescriptor";
+			}
+
+			// As in deserializeElement(), referenced elements are not checked against the target namespace
+			writeFieldDescriptorDefinition(writer, pElement->getName(), ((*elem)->hasRef() ? QString() : getNamespaceUri()), szFlags,
+					pElement->getMinOccurs(), pElement->getMaxOccurs(),
+					szTypeDescriptor, szValueDescriptor, szAccessor, "NULL", "NULL");
+		}
+
+		if(iCount > 0) {
+			writer << CodeWriter::Unindent << "};" << CodeWriter::EndLine;
+			writer << CodeWriter::EndLine;
+		}
+
+		if(!getExtensionType().isNull()) {
+			QString szExtensionName;
+			if(getExtensionType()->getTypeMode() == Type::TypeSimple){
+				SimpleTypeSharedPtr pSimpleType = qSharedPointerCast<SimpleType>(getExtensionType());
+				szExtensionName = pSimpleType->getCPPTypeNameString();
+				szBaseValueDescriptor = "&ValueTraits<" + szExtensionName + ">::descriptor";
+			}else{
+				szExtensionName = getExtensionType()->getNameWithNamespace();
+				szBaseTypeDescriptor = "&" + szExtensionName + "::s_typeDescriptor";
+			}
+			szToConstBase = "&BaseCast<" + szClassname + ", " + szExtensionName + ">::toConstBase";
+			szToBase = "&BaseCast<" + szClassname + ", " + szExtensionName + ">::toBase";
+		}
+	}else{
+		// The class keeps its generated body, the descriptor only forwards to it
+		szSerialize = "&TypeTraits<" + szClassname + ">::serialize";
+		szDeserialize = "&TypeTraits<" + szClassname + ">::deserialize";
+		szRead = "&TypeTraits<" + szClassname + ">::read";
+		szReadAttributes = "&TypeTraits<" + szClassname + ">::readAttributes";
+		szReadElement = "&TypeTraits<" + szClassname + ">::readElement";
+	}
+
+	writer << "const TypeDescriptor " << szClassname << "::s_typeDescriptor = " << CodeWriter::BeginBlock;
+	writer << "\"" << getLocalName() << "\", \"" << szNamespace << "\"," << CodeWriter::EndLine;
+	writer << szFields << ", " << iCount << "," << CodeWriter::EndLine;
+	writer << szBaseTypeDescriptor << ", " << szBaseValueDescriptor << ", " << szToConstBase << ", " << szToBase << "," << CodeWriter::EndLine;
+	writer << "&TypeTraits<" << szClassname << ">::isNull," << CodeWriter::EndLine;
+	writer << szSerialize << ", " << szDeserialize << "," << CodeWriter::EndLine;
+	writer << szRead << ", " << szReadAttributes << ", " << szReadElement << CodeWriter::EndLine;
+	writer << CodeWriter::Unindent << "};" << CodeWriter::EndLine;
+}
+
+int ComplexType::getFieldDescriptorCount() const
+{
+	AttributeList::const_iterator attr;
+	ElementList::const_iterator elem;
+	int iCount = 0;
+
+	for(attr = m_pListAttribute->constBegin(); attr != m_pListAttribute->constEnd(); ++attr) {
+		if(((*attr)->hasRef() ? (*attr)->getRef() : *attr)->getType()) {
+			iCount++;
+		}
+	}
+	for(elem = m_pListElement->constBegin(); elem != m_pListElement->constEnd(); ++elem) {
+		if(((*elem)->hasRef() ? (*elem)->getRef() : *elem)->getType()) {
+			iCount++;
+		}
+	}
+	return iCount;
+}
+
+void ComplexType::writeFieldDescriptorDefinition(CodeWriter& writer, const QString& szName, const QString& szNamespaceUri, const QString& szFlags, int iMinOccurs, int iMaxOccurs,
+		const QString& szTypeDescriptor, const QString& szValueDescriptor, const QString& szAccessor, const QString& szDeserializeAttribute,
+		const QString& szReadAttribute)
+{
+	writer << "{\"" << szName << "\", 0x" << QString::number(ModelUtils::getNameHash(szName), 16) << "U, ";
+	if(szNamespaceUri.isEmpty()) {
+		writer << "NULL, ";
+	}else{
+		writer << "\"" << szNamespaceUri << "\", ";
+	}
+	writer << szFlags << ", " << iMinOccurs << ", " << iMaxOccurs << "," << CodeWriter::EndLine;
+	writer << CodeWriter::Indent;
+	writer << szTypeDescriptor << ", " << szValueDescriptor << "," << CodeWriter::EndLine;
+	writer << "&" << szAccessor << "::count," << CodeWriter::EndLine;
+	writer << "&" << szAccessor << "::item," << CodeWriter::EndLine;
+	writer << "&" << szAccessor << "::append," << CodeWriter::EndLine;
+	writer << szDeserializeAttribute << ", " << szReadAttribute << "}," << CodeWriter::EndLine;
+	writer << CodeWriter::Unindent;
 }
 
 QString ComplexType::getVariableDeclaration(const QString& szName) const
@@ -1472,6 +2168,24 @@ QString ComplexType::getGetNamespaceDeclarationDeclaration() const
 	return "static QList<QString> getNamespaceDeclaration();";
 }
 
+QString ComplexType::getArenaOperatorsDeclaration() const
+{
+	return "static void* operator new(size_t iSize);" CRLF
+			"\tstatic void operator delete(void* pObject);";
+}
+
+QString ComplexType::getCopyMoveDeclaration(const QString& szClassname) const
+{
+	QString szDeclaration;
+	szDeclaration += "%0(const %0& other);" CRLF;
+	szDeclaration += "\t%0& operator=(const %0& other);" CRLF;
+	szDeclaration += "#ifdef Q_COMPILER_RVALUE_REFS" CRLF;
+	szDeclaration += "\t%0(%0&& other);" CRLF;
+	szDeclaration += "\t%0& operator=(%0&& other);" CRLF;
+	szDeclaration += "#endif";
+	return szDeclaration.arg(szClassname);
+}
+
 QString ComplexType::getVariableName() const
 {
 	return "_" + ModelUtils::getUncapitalizedName(getLocalName());
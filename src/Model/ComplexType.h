@@ -10,10 +10,14 @@
 
 #include <QSharedPointer>
 #include <QList>
+#include <QSet>
 #include <QString>
+#include <QStringList>
 
 #include "Type.h"
 
+class CodeWriter;
+
 class Element
 {
 public:
@@ -58,12 +62,10 @@ public:
 	QString getGetterDeclaration() const;
 	QString getSerializerDeclaration() const;
 	QString getDeserializerDeclaration() const;
-	QString getVariableDeclaration() const;
+	void writeVariableDeclaration(CodeWriter& writer) const;
 
 	QString getSetterDefinition(const QString& szClassname) const;
 	QString getGetterDefinition(const QString& szClassname) const;
-	QString getSerializerDefinition(const QString& szClassname, const QString& szNamespace) const;
-	QString getDeserializerDefinition(const QString& szClassname) const;
 
 private:
 	ElementSharedPtr m_pRef;
@@ -120,7 +122,7 @@ public:
 
 	QString getSetterDeclaration() const;
 	QString getGetterDeclaration() const;
-	QString getVariableDeclaration() const;
+	void writeVariableDeclaration(CodeWriter& writer) const;
 
 	QString getSetterDefinition(const QString& szClassname) const;
 	QString getGetterDefinition(const QString& szClassname) const;
@@ -176,21 +178,51 @@ public:
 	QString getSetterDeclaration(const QString& szName = QString()) const;
 	QString getGetterDeclaration(const QString& szName = QString()) const;
 	QString getSerializerDeclaration() const;
+	QString getBufferSerializerDeclaration() const;
 	QString getDeserializerDeclaration() const;
 	QString getVariableDeclaration(const QString& szName = QString()) const;
 	QString getIsNullDeclaration() const;
 	QString getGetNamespaceDeclarationDeclaration() const;
+	QString getArenaOperatorsDeclaration() const;
+	QString getCopyMoveDeclaration(const QString& szClassname) const;
 
 	QString getSetterDefinition(const QString& szClassname, const QString& szName = QString()) const;
 	QString getGetterDefinition(const QString& szClassname, const QString& szName = QString()) const;
-	QString getSerializerDefinition(const QString& szClassname, const QString& szNamespace = QString()) const;
-	QString getDeserializerDefinition(const QString& szClassname) const;
-	QString getIsNullDefinition(const QString& szClassname) const;
-	QString getGetNamespaceDeclarationDefinition(const QString& szClassname) const;
+	void writeSerializerDefinition(CodeWriter& writer, const QString& szClassname, const QString& szNamespace = QString()) const;
+	void writeDeserializerDefinition(CodeWriter& writer, const QString& szClassname) const;
+	void writeStreamDeserializerDefinition(CodeWriter& writer, const QString& szClassname) const;
+	void writeIsNullDefinition(CodeWriter& writer, const QString& szClassname) const;
+	void writeGetNamespaceDeclarationDefinition(CodeWriter& writer, const QString& szClassname) const;
+	void writeArenaOperatorsDefinition(CodeWriter& writer, const QString& szClassname) const;
+	// Constructor, destructor, copy and move operations; szBaseClassname is empty without extension
+	void writeLifecycleDefinition(CodeWriter& writer, const QString& szClassname, const QString& szBaseClassname) const;
+	// Transitive and deduplicated namespace declarations of the type, its base and its members
+	QStringList getNamespaceDeclarationList() const;
+
+	// Table-driven serialization (see TypeDescriptor.h in resources)
+	bool isTableSerializable() const;
+	QString getTypeDescriptorDeclaration() const;
+	QString getFieldDescriptorDeclaration() const;
+	void writeTableSerializerDefinition(CodeWriter& writer, const QString& szClassname) const;
+	void writeTableDeserializerDefinition(CodeWriter& writer, const QString& szClassname) const;
+	void writeTypeDescriptorDefinition(CodeWriter& writer, const QString& szClassname, const QString& szNamespace) const;
 
 	QString getVariableName() const;
 
 private:
+	void buildNamespaceDeclarationList(QStringList& listNamespaceDeclaration, QSet<const ComplexType*>& setVisitedTypes) const;
+	// Members held by value, owned pointer members and lists of owned pointers as (name, type)
+	// pairs, in declaration order
+	void getMemberList(QStringList& listValueMembers, QList<QPair<QString, QString> >& listPointerMembers,
+			QList<QPair<QString, QString> >& listPointerListMembers) const;
+	// Copy of the items of a list of owned pointers from "other"
+	static void writePointerListCopy(CodeWriter& writer, const QString& szName, const QString& szType);
+	void writeStreamElementDeserializer(CodeWriter& writer, const ElementSharedPtr& pElement) const;
+	int getFieldDescriptorCount() const;
+	static void writeFieldDescriptorDefinition(CodeWriter& writer, const QString& szName, const QString& szNamespaceUri, const QString& szFlags, int iMinOccurs, int iMaxOccurs,
+			const QString& szTypeDescriptor, const QString& szValueDescriptor, const QString& szAccessor, const QString& szDeserializeAttribute,
+			const QString& szReadAttribute);
+
 	AttributeListSharedPtr m_pListAttribute;
 	ElementListSharedPtr m_pListElement;
 
@@ -6,6 +6,7 @@
  */
 
 #include <Utils/ModelUtils.h>
+#include <Utils/CodeWriter.h>
 
 #include "Operation.h"
 
@@ -100,92 +101,256 @@ QString Operation::getOperationDeclaration() const
 			szDeclaration += "& ";
 			szDeclaration += m_pSoapEnvFaultType->getLocalName();
 		}
-		szDeclaration += ");";
+		szDeclaration += ", OperationResult* pResult = NULL);";
 	}
 
 	return szDeclaration;
 }
 
-QString Operation::getOperationDefinition(const QString& szClassname, const QString& szNamespace) const
+QString Operation::getAsyncOperationDeclaration() const
+{
+	QString szDeclaration;
+	if(m_pInputMessage->getParameter() && m_pOutputMessage->getParameter())
+	{
+		szDeclaration += "void ";
+		szDeclaration += m_szName;
+		szDeclaration += "Async(const ";
+		szDeclaration += m_pInputMessage->getParameter()->getNameWithNamespace();
+		szDeclaration += "& ";
+		szDeclaration += m_pInputMessage->getParameter()->getLocalName();
+		szDeclaration += ", ";
+		szDeclaration += getCallbackTypeName();
+		szDeclaration += "* pCallback);";
+	}
+
+	return szDeclaration;
+}
+
+QString Operation::getBatchOperationDeclaration() const
+{
+	QString szDeclaration;
+	if(m_pInputMessage->getParameter() && m_pOutputMessage->getParameter())
+	{
+		szDeclaration += getBatchResultListTypeName();
+		szDeclaration += " ";
+		szDeclaration += m_szName;
+		szDeclaration += "Batch(const QList<";
+		szDeclaration += m_pInputMessage->getParameter()->getNameWithNamespace();
+		szDeclaration += ">& listRequests, int iWindow = 16, BatchStatistics* pStatistics = NULL);";
+	}
+
+	return szDeclaration;
+}
+
+QString Operation::getPrepareQueryDeclaration() const
+{
+	QString szDeclaration;
+	if(m_pInputMessage->getParameter() && m_pOutputMessage->getParameter())
+	{
+		szDeclaration += "void ";
+		szDeclaration += getPrepareQueryName();
+		szDeclaration += "(const ";
+		szDeclaration += m_pInputMessage->getParameter()->getNameWithNamespace();
+		szDeclaration += "& ";
+		szDeclaration += m_pInputMessage->getParameter()->getLocalName();
+		szDeclaration += ", QNetworkRequest& request, QByteArray& soapMessage) const;";
+	}
+
+	return szDeclaration;
+}
+
+QString Operation::getPrepareQueryName() const
+{
+	return "prepare" + ModelUtils::getCapitalizedName(m_szName) + "Query";
+}
+
+QString Operation::getCallbackTypeName() const
+{
+	QString szTypeName = "IOperationCallback<" + m_pOutputMessage->getParameter()->getNameWithNamespace();
+	if(m_pSoapEnvFaultType){
+		szTypeName += ", " + m_pSoapEnvFaultType->getNameWithNamespace();
+	}
+	szTypeName += ">";
+	return szTypeName;
+}
+
+QString Operation::getBatchResultListTypeName() const
+{
+	QString szTypeName = "QList<BatchResult<" + m_pOutputMessage->getParameter()->getNameWithNamespace();
+	if(m_pSoapEnvFaultType){
+		szTypeName += ", " + m_pSoapEnvFaultType->getNameWithNamespace();
+	}
+	szTypeName += "> >";
+	return szTypeName;
+}
+
+void Operation::writeOperationDefinition(CodeWriter& writer, const QString& szClassname, const QString& szNamespace) const
 {
 	if(!m_pInputMessage->getParameter() || !m_pOutputMessage->getParameter()){
-		return "";
+		return;
 	}
 
 	QString szInputName = ModelUtils::getUncapitalizedName(m_pInputMessage->getParameter()->getLocalName());
 	QString szOutputName = ModelUtils::getUncapitalizedName(m_pOutputMessage->getParameter()->getLocalName());
 
-	QString szDefinition;
-	szDefinition += "bool " + szClassname + "::" + m_szName + "(const " + m_pInputMessage->getParameter()->getNameWithNamespace() +
-			"& " + szInputName + ", " + m_pOutputMessage->getParameter()->getNameWithNamespace() +
-			"& " + szOutputName;
+	// Request shared by the blocking and asynchronous variants
+	writer << "void " << szClassname << "::" << getPrepareQueryName() << "(const " << m_pInputMessage->getParameter()->getNameWithNamespace()
+			<< "& " << szInputName << ", QNetworkRequest& request, QByteArray& soapMessage) const" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	// Constant parts of the request are built on the first call only
+	writer << "static const QByteArray contentType(\"application/soap+xml; charset=utf-8; action=\\\"" << m_szSoapAction << "\\\"\");" << CodeWriter::EndLine;
+	writer << "static const QByteArray soapAction(\"" << m_szSoapAction << "\");" << CodeWriter::EndLine;
+	writer << "static const QByteArray soapEnvelopePrefix = buildSoapEnvelopePrefix(" << m_pInputMessage->getParameter()->getNameWithNamespace() << "::getNamespaceDeclaration());" << CodeWriter::EndLine;
+	writer << CodeWriter::EndLine;
+	writer << "request = buildNetworkRequest();" << CodeWriter::EndLine;
+	writer << "setSoapHeaders(request, contentType, soapAction);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndLine;
+	writer << "startSoapMessage(soapMessage, soapEnvelopePrefix);" << CodeWriter::EndLine;
+	writer << szInputName << ".serialize(soapMessage);" << CodeWriter::EndLine;
+	writer << "endSoapMessage(soapMessage);" << CodeWriter::EndLine;
 
+	// Debug request
+	writer << "if(m_bDebug)" << CodeWriter::BeginBlock;
+	writer << "qWarning(\"Message:\\n%s\", qPrintable(QString::fromUtf8(soapMessage)));" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+
+	writer << "bool " << szClassname << "::" << m_szName << "(const " << m_pInputMessage->getParameter()->getNameWithNamespace()
+			<< "& " << szInputName << ", " << m_pOutputMessage->getParameter()->getNameWithNamespace()
+			<< "& " << szOutputName;
 	if(m_pSoapEnvFaultType){
-		szDefinition += ", " + m_pSoapEnvFaultType->getNameWithNamespace() + "& " + m_pSoapEnvFaultType->getLocalName() + ")" CRLF;
-	}else{
-		szDefinition += ")" CRLF;
+		writer << ", " << m_pSoapEnvFaultType->getNameWithNamespace() << "& " << m_pSoapEnvFaultType->getLocalName();
 	}
-	szDefinition += "{" CRLF;
-	szDefinition += "\tbool bGoOn = true;" CRLF;
-	szDefinition += CRLF;
-	szDefinition += "\tQNetworkRequest request = buildNetworkRequest();" CRLF;
-	szDefinition += "\trequest.setRawHeader(QString(\"Content-Type\").toLatin1(), QString(\"application/soap+xml; charset=utf-8; action=\\\"" + m_szSoapAction + "\\\"\").toLatin1());" CRLF;
-	szDefinition += "\trequest.setRawHeader(QString(\"Accept-Encoding\").toLatin1(), QString(\"gzip, deflate\").toLatin1());" CRLF;
-	szDefinition += "\trequest.setRawHeader(QString(\"SoapAction\").toLatin1(), QString(\"" + m_szSoapAction + "\").toLatin1());" CRLF;
-	szDefinition += CRLF;
-	szDefinition += "\tQByteArray soapMessage = buildSoapMessage(" + szInputName + ".serialize(), " + m_pInputMessage->getParameter()->getNameWithNamespace() + "::getNamespaceDeclaration());" CRLF;
-
-	// Debug request
-	szDefinition += "\tif(m_bDebug){" CRLF;
-	szDefinition += "\t\tqWarning(\"Message:\\n%s\", qPrintable(QString::fromUtf8(soapMessage)));" CRLF;
-	szDefinition += "\t}" CRLF;
-	szDefinition += CRLF;
-
-	szDefinition += CRLF;
-	szDefinition += "\tIQueryExecutorResponse response = m_pQueryExecutor->execQuery(request, soapMessage);" CRLF;
-	szDefinition += "\tQString szErrorMsg;" CRLF;
-	szDefinition += "\tint iErrorLine = -1;" CRLF;
-	szDefinition += "\tint iErrorColumn = -1;" CRLF;
-	szDefinition += "\tQDomDocument doc;" CRLF;
-	szDefinition += "\tQMap<QString, QString> namespaceRoutingMap;" CRLF;
-	szDefinition += CRLF;
-	szDefinition += "\tif(doc.setContent(response.getResponse(), &szErrorMsg, &iErrorLine, &iErrorColumn)){" CRLF;
-	szDefinition += "\t\tnamespaceRoutingMap = buildNamespaceRoutingMap(doc);" CRLF;
-	szDefinition += CRLF;
+	writer << ", OperationResult* pResult)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	// The outcome is kept in the result only, the service can be shared between threads
+	writer << "OperationResult result;" << CodeWriter::EndLine;
+	writer << "result.start();" << CodeWriter::EndLine;
+	writer << CodeWriter::EndLine;
+	writer << "QNetworkRequest request;" << CodeWriter::EndLine;
+	writer << "QByteArray soapMessage;" << CodeWriter::EndLine;
+	writer << getPrepareQueryName() << "(" << szInputName << ", request, soapMessage);" << CodeWriter::EndLine;
+	writer << "result.setRequestPrepared(soapMessage.size());" << CodeWriter::EndLine;
+	writer << CodeWriter::EndLine;
+	writeCacheLookup(writer, szOutputName, false);
+	writer << "setLastResult(result);" << CodeWriter::EndLine;
+	writer << "if(pResult)" << CodeWriter::BeginBlock;
+	writer << "*pResult = result;" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << "return true;" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+	writer << "compressSoapMessage(request, soapMessage, result);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndLine;
+	// The response is parsed while it is received
+	writer << "QIODevice* pReplyDevice = m_pQueryExecutor->openQuery(request, soapMessage);" << CodeWriter::EndLine;
+	writer << "QXmlStreamReader reader(pReplyDevice);" << CodeWriter::EndLine;
+	writer << "ObjectArena::Scope arenaScope(m_pObjectArena);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndLine;
+	writer << "if(readSoapBodyContent(reader))" << CodeWriter::BeginBlock;
+	if(m_pSoapEnvFaultType){
+		writer << "if(isSoapFault(reader))" << CodeWriter::BeginBlock;
+		writer << "Fault.deserialize(reader);" << CodeWriter::EndLine;
+		writer << "result.setSoapFault();" << CodeWriter::EndLine;
+		writer << CodeWriter::Unindent << "}else{" << CodeWriter::EndLine << CodeWriter::Indent;
+	}
+	writer << szOutputName << ".deserialize(reader);" << CodeWriter::EndLine;
+	if(m_pSoapEnvFaultType){
+		writer << CodeWriter::EndBlock;
+	}
+	writer << CodeWriter::EndBlock;
+	writer << "if(reader.hasError())" << CodeWriter::BeginBlock;
+	writer << "result.setParseError(reader.errorString());" << CodeWriter::EndLine;
+	writer << "qWarning(\"[" << szNamespace << "::" << m_szName << "] Error during parsing response : %s (%d:%d)\", qPrintable(reader.errorString()), (int)reader.lineNumber(), (int)reader.columnNumber());" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+	writer << "IQueryExecutorResponse response;" << CodeWriter::EndLine;
+	writer << "m_pQueryExecutor->closeQuery(pReplyDevice, response);" << CodeWriter::EndLine;
+	writer << "result.setResponse(response);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndLine;
+	writer << "if(response.getHttpStatusCode() != 200)" << CodeWriter::BeginBlock;
+	writer << "qWarning(\"[" << szNamespace << "::" << m_szName << "] Error with HTTP status code: %d\", response.getHttpStatusCode());" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+
+	writer << "if(m_bDebug)" << CodeWriter::BeginBlock;
+	writer << "qWarning(\"Response:\\n%s\", qPrintable(QString::fromUtf8(response.getResponse())));" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+
+	writer << "if(iCacheTtl > 0 && result.isSuccess())" << CodeWriter::BeginBlock;
+	writer << "cacheResponse(cacheKey, " << szOutputName << ", response.getResponse(), iCacheTtl);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+
+	writer << "setLastResult(result);" << CodeWriter::EndLine;
+	writer << "if(pResult)" << CodeWriter::BeginBlock;
+	writer << "*pResult = result;" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << "return result.isSuccess();" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+
+	// Asynchronous variant, the response is parsed by AsyncOperation when it is received
+	writer << "void " << szClassname << "::" << m_szName << "Async(const " << m_pInputMessage->getParameter()->getNameWithNamespace()
+			<< "& " << szInputName << ", " << getCallbackTypeName() << "* pCallback)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "OperationResult result;" << CodeWriter::EndLine;
+	writer << "result.start();" << CodeWriter::EndLine;
+	writer << CodeWriter::EndLine;
+	writer << "QNetworkRequest request;" << CodeWriter::EndLine;
+	writer << "QByteArray soapMessage;" << CodeWriter::EndLine;
+	writer << getPrepareQueryName() << "(" << szInputName << ", request, soapMessage);" << CodeWriter::EndLine;
+	writer << "result.setRequestPrepared(soapMessage.size());" << CodeWriter::EndLine;
+	writer << CodeWriter::EndLine;
+	writeCacheLookup(writer, szOutputName, true);
+	writer << (m_pSoapEnvFaultType ? m_pSoapEnvFaultType->getNameWithNamespace() : QString("NoFault")) << " fault;" << CodeWriter::EndLine;
+	writer << "setLastResult(result);" << CodeWriter::EndLine;
+	writer << "pCallback->operationFinished(true, " << szOutputName << ", fault);" << CodeWriter::EndLine;
+	writer << "return;" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+	writer << "compressSoapMessage(request, soapMessage, result);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndLine;
+	writer << "m_pQueryExecutor->postQuery(request, soapMessage, new AsyncOperation<" << m_pOutputMessage->getParameter()->getNameWithNamespace();
 	if(m_pSoapEnvFaultType){
-		szDefinition += "\t\tQString szNamespace = namespaceRoutingMap.value(SOAP_ENV_URI, " + szNamespace + "::" + m_pSoapEnvFaultType->getNameWithNamespace() + "TargetNamespace);" CRLF;
-		szDefinition += "\t\tQString szFaultTagName = szNamespace + \":Fault\";" CRLF;
-		szDefinition += "\t\tif(doc.elementsByTagName(szFaultTagName).size() > 0){" CRLF;
-		szDefinition += "\t\t\tQDomElement root = doc.elementsByTagName(szFaultTagName).at(0).toElement();" CRLF;
-		szDefinition += "\t\t\tFault.deserialize(root);" CRLF;
-		szDefinition += "\t\t\tbGoOn = false;" CRLF;
-		szDefinition += "\t\t}else{" CRLF;
+		writer << ", " << m_pSoapEnvFaultType->getNameWithNamespace();
+	}else{
+		writer << ", NoFault";
 	}
-	szDefinition += "\t\t" + QString(m_pSoapEnvFaultType ? "\t" : "") + "QDomElement root = doc.elementsByTagName(namespaceRoutingMap.value(SOAP_ENV_URI, DEFAULT_SOAP_ENV_NAMESPACE) + \":Body\").at(0).firstChildElement();" CRLF;
-	szDefinition += "\t\t" + QString(m_pSoapEnvFaultType ? "\t" : "") + szOutputName + ".deserialize(root);" CRLF;
+	writer << ">(this, pCallback, result, cacheKey, iCacheTtl));" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+
+	// Batch over the asynchronous variant
+	writer << getBatchResultListTypeName() << " " << szClassname << "::" << m_szName << "Batch(const QList<" << m_pInputMessage->getParameter()->getNameWithNamespace()
+			<< ">& listRequests, int iWindow, BatchStatistics* pStatistics)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "return OperationBatch<" << szClassname << ", " << m_pInputMessage->getParameter()->getNameWithNamespace() << ", " << m_pOutputMessage->getParameter()->getNameWithNamespace();
 	if(m_pSoapEnvFaultType){
-		szDefinition += "\t\t}" CRLF;
+		writer << ", " << m_pSoapEnvFaultType->getNameWithNamespace();
+	}
+	writer << ">::run(this, &" << szClassname << "::" << m_szName << "Async, listRequests, iWindow, pStatistics);" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+}
+
+void Operation::writeCacheLookup(CodeWriter& writer, const QString& szOutputName, bool bDeclareOutput) const
+{
+	// Leaves the blocks of the lookup and of the hit open for the caller to return the response
+	writer << "int iCacheTtl = getOperationCacheTtl(\"" << m_szName << "\");" << CodeWriter::EndLine;
+	writer << "QByteArray cacheKey;" << CodeWriter::EndLine;
+	writer << "if(iCacheTtl > 0)" << CodeWriter::BeginBlock;
+	writer << "cacheKey = ResponseCache::buildKey(m_url, \"" << m_szName << "\", soapMessage);" << CodeWriter::EndLine;
+	if(bDeclareOutput){
+		writer << m_pOutputMessage->getParameter()->getNameWithNamespace() << " " << szOutputName << ";" << CodeWriter::EndLine;
 	}
-	szDefinition += "\t}else{" CRLF;
-	szDefinition += "\t\tbGoOn = false;" CRLF;
-	szDefinition += "\t\tqWarning(\"[" + szNamespace + "::" + m_szName + "] Error during parsing response : %s (%d:%d)\", qPrintable(szErrorMsg), iErrorLine, iErrorColumn);" CRLF;
-	szDefinition += "\t}" CRLF;
-	szDefinition += CRLF;
-	szDefinition += "\tif(response.getHttpStatusCode() != 200){" CRLF;
-	szDefinition += "\t\tbGoOn = false;" CRLF;
-	szDefinition += "\t\tqWarning(\"[" + szNamespace + "::" + m_szName + "] Error with HTTP status code: %d\", response.getHttpStatusCode());" CRLF;
-	szDefinition += "\t}" CRLF;
-	szDefinition += CRLF;
-
-	szDefinition += "\tif(m_bDebug){" CRLF;
-	szDefinition += "\t\tqWarning(\"Response:\\n%s\", qPrintable(QString::fromUtf8(response.getResponse())));" CRLF;
-	szDefinition += "\t}" CRLF;
-	szDefinition += CRLF;
-
-	szDefinition += "\treturn bGoOn;" CRLF;
-	szDefinition += "}" CRLF;
-
-	return szDefinition;
+	writer << "QByteArray rawResponse;" << CodeWriter::EndLine;
+	writer << "ObjectArena::Scope arenaScope(m_pObjectArena);" << CodeWriter::EndLine;
+	writer << "if(m_pResponseCache->find(cacheKey, " << szOutputName << ", &rawResponse))" << CodeWriter::BeginBlock;
+	writer << "result.setCachedResponse(rawResponse);" << CodeWriter::EndLine;
 }
 
 OperationList::OperationList()
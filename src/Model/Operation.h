@@ -12,6 +12,8 @@
 
 #include "Message.h"
 
+class CodeWriter;
+
 class Operation;
 typedef QSharedPointer<Operation> OperationSharedPtr;
 class OperationList;
@@ -42,9 +44,18 @@ public:
 	QString getSoapAction() const;
 
 	QString getOperationDeclaration() const;
-	QString getOperationDefinition(const QString& szClassname, const QString& szNamespace) const;
+	QString getAsyncOperationDeclaration() const;
+	QString getBatchOperationDeclaration() const;
+	QString getPrepareQueryDeclaration() const;
+	void writeOperationDefinition(CodeWriter& writer, const QString& szClassname, const QString& szNamespace) const;
 
 private:
+	QString getPrepareQueryName() const;
+	QString getCallbackTypeName() const;
+	QString getBatchResultListTypeName() const;
+	// Open the blocks of a lookup in the response cache and of a hit
+	void writeCacheLookup(CodeWriter& writer, const QString& szOutputName, bool bDeclareOutput) const;
+
 	QString m_szName;
 	QString m_szSoapAction;
 
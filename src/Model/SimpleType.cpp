@@ -7,6 +7,7 @@
 
 #include "../Utils/StringUtils.h"
 #include "../Utils/ModelUtils.h"
+#include "../Utils/CodeWriter.h"
 
 #include "SimpleType.h"
 
@@ -350,8 +351,10 @@ QString SimpleType::getSerializerDeclaration() const
 QString SimpleType::getDeserializerDeclaration() const
 {
 	QString szRet = "void deserialize(const QDomElement& element);";
+	szRet += CRLF "\tvoid deserialize(QXmlStreamReader& reader);";
 	if(isEnumeration()){
 		szRet += CRLF "\tvoid deserialize(const QDomAttr& attr);";
+		szRet += CRLF "\tvoid deserialize(const QXmlStreamAttribute& attr);";
 	}
 	return szRet;
 }
@@ -496,143 +499,132 @@ QString SimpleType::getGetterDefinitionForComplexType(const QString& szClassname
 	return szDefinition.arg(szMemberType).arg(szClassname).arg(szFuncName).arg(szMemberName);
 }
 
-QString SimpleType::getSerializerDefinition(const QString& szClassname) const
+void SimpleType::writeSerializerDefinition(CodeWriter& writer, const QString& szClassname) const
 {
 	QString szFuncName = ModelUtils::getCapitalizedName(getLocalName());
-	QString szMemberName = getVariableName();
 
+	writer << "QString " << szClassname << "::serialize() const" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "if(!isNull())" << CodeWriter::BeginBlock;
 	if(isEnumeration()) {
-
-		QString szDefinition = ""
-		"QString %0::serialize() const" CRLF
-		"{" CRLF
-		"\tif(!isNull()) {" CRLF
-		"\t\treturn get%1ToString();" CRLF
-		"\t}" CRLF
-		"\t return \"\";" CRLF
-		"}" CRLF;
-
-		return szDefinition.arg(szClassname).arg(szFuncName);
-
-	} else {
-		QString szDefinition = ""
-		"QString %0::serialize() const" CRLF
-		"{" CRLF
-		"\tif(!isNull()) {" CRLF
-		"\t\treturn \"<%1>\" + %2.serialize() + \"</%1>\";" CRLF
-		"\t}" CRLF
-		"\t return \"\";" CRLF
-		"}" CRLF;
-
-		return szDefinition.arg(szClassname).arg(szFuncName).arg(szMemberName);
+		writer << "return get" << szFuncName << "ToString();" << CodeWriter::EndLine;
+	}else{
+		writer << "return \"<" << szFuncName << ">\" + " << getVariableName() << ".serialize() + \"</" << szFuncName << ">\";" << CodeWriter::EndLine;
 	}
+	writer << CodeWriter::EndBlock;
+	writer << "return \"\";" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
 }
 
-QString SimpleType::getDeserializerDefinition(const QString& szClassname) const
+void SimpleType::writeDeserializerDefinition(CodeWriter& writer, const QString& szClassname) const
 {
 	QString szFuncName = ModelUtils::getCapitalizedName(getLocalName());
 	QString szMemberName = getVariableName();
 
 	if(isEnumeration()) {
+		writer << "void " << szClassname << "::deserialize(const QDomElement& element)" << CodeWriter::EndLine;
+		writer << CodeWriter::BeginBlock;
+		writer << "set" << szFuncName << "FromString(element.text().trimmed());" << CodeWriter::EndLine;
+		writer << CodeWriter::EndBlock;
+		writer << CodeWriter::EndLine;
+
+		writer << "void " << szClassname << "::deserialize(const QDomAttr& attr)" << CodeWriter::EndLine;
+		writer << CodeWriter::BeginBlock;
+		writer << "set" << szFuncName << "FromString(attr.value().trimmed());" << CodeWriter::EndLine;
+		writer << CodeWriter::EndBlock;
+		writer << CodeWriter::EndLine;
+
+		writer << "void " << szClassname << "::deserialize(QXmlStreamReader& reader)" << CodeWriter::EndLine;
+		writer << CodeWriter::BeginBlock;
+		writer << "set" << szFuncName << "FromString(reader.readElementText().trimmed());" << CodeWriter::EndLine;
+		writer << CodeWriter::EndBlock;
+		writer << CodeWriter::EndLine;
+
+		writer << "void " << szClassname << "::deserialize(const QXmlStreamAttribute& attr)" << CodeWriter::EndLine;
+		writer << CodeWriter::BeginBlock;
+		writer << "set" << szFuncName << "FromString(attr.value().toString().trimmed());" << CodeWriter::EndLine;
+		writer << CodeWriter::EndBlock;
 
-		QString szDefinition = ""
-				"void %0::deserialize(const QDomElement& element)" CRLF
-				"{" CRLF
-				"\tset%1FromString(element.text().trimmed());" CRLF
-				"}" CRLF CRLF;
-
-		szDefinition += "void %0::deserialize(const QDomAttr& attr)" CRLF
-				"{" CRLF
-				"\tset%1FromString(attr.value().trimmed());" CRLF
-				"}" CRLF;
-
-		return szDefinition.arg(szClassname).arg(szFuncName);
-
-	} else {
-		QString szDefinition = ""
-		"void %0::deserialize(const QDomElement& element)" CRLF
-		"{" CRLF
-		"\tQDomElement child = element.firstChild().toElement();" CRLF
-		"\twhile(!child.isNull()) {" CRLF
-		"\t\tif((child.tagName() == \"%1\") || child.tagName().endsWith(\"%2\")) {" CRLF
-		"\t\t%3.deserialize(child);" CRLF
-		"\t\t}" CRLF
-		"\tchild = child.nextSibling().toElement();" CRLF
-		"\t}" CRLF
-		"}" CRLF;
-
-		return szDefinition.arg(szClassname).arg(getTagQualifiedName()).arg(szFuncName).arg(szMemberName);
+	}else{
+		writer << "void " << szClassname << "::deserialize(const QDomElement& element)" << CodeWriter::EndLine;
+		writer << CodeWriter::BeginBlock;
+		writer << "QDomElement child = element.firstChild().toElement();" << CodeWriter::EndLine;
+		writer << "while(!child.isNull())" << CodeWriter::BeginBlock;
+		writer << "if((child.tagName() == \"" << getTagQualifiedName() << "\") || child.tagName().endsWith(\"" << szFuncName << "\"))" << CodeWriter::BeginBlock;
+		writer << szMemberName << ".deserialize(child);" << CodeWriter::EndLine;
+		writer << CodeWriter::EndBlock;
+		writer << "child = child.nextSibling().toElement();" << CodeWriter::EndLine;
+		writer << CodeWriter::EndBlock;
+		writer << CodeWriter::EndBlock;
+		writer << CodeWriter::EndLine;
+
+		writer << "void " << szClassname << "::deserialize(QXmlStreamReader& reader)" << CodeWriter::EndLine;
+		writer << CodeWriter::BeginBlock;
+		writer << "while(reader.readNextStartElement())" << CodeWriter::BeginBlock;
+		writer << "if((reader.name() == QLatin1String(\"" << getLocalName() << "\")) || (reader.name() == QLatin1String(\"" << szFuncName << "\")))" << CodeWriter::BeginBlock;
+		writer << szMemberName << ".deserialize(reader);" << CodeWriter::EndLine;
+		writer << CodeWriter::Unindent << "}else{" << CodeWriter::EndLine << CodeWriter::Indent;
+		writer << "reader.skipCurrentElement();" << CodeWriter::EndLine;
+		writer << CodeWriter::EndBlock;
+		writer << CodeWriter::EndBlock;
+		writer << CodeWriter::EndBlock;
 	}
 }
 
-QString SimpleType::getEnumConvertDefinition(const QString& szClassname) const
+void SimpleType::writeEnumConvertDefinition(CodeWriter& writer, const QString& szClassname) const
 {
-	QString szDefinition;
+	if(!isEnumeration()) {
+		return;
+	}
 
 	QString szFuncName = ModelUtils::getCapitalizedName(getLocalName());
+	QString szMemberName = getVariableName();
+	QStringList listValues = getEnumerationValues();
 
-	if(isEnumeration()) {
-
-		szDefinition += ""
-		"void %0::set%1FromString(const QString& szValue)" CRLF
-		"{" CRLF
-		"\tif((szValue == \"" + getEnumerationValues()[0] + "\") || szValue.endsWith(\":" + StringUtils::getLocalNameIfPossible(getEnumerationValues()[0]) + "\")) {" CRLF
-		"\t\t %2 = %0::" + StringUtils::removeNonAlphaNum(getEnumerationValues()[0]) + ";" CRLF
-		"\t}";
-
-		for(int i=1; i < getEnumerationValues().count(); ++i) {
-			szDefinition += ""
-			"else if((szValue == \"" + getEnumerationValues()[i] + "\") || szValue.endsWith(\":" + StringUtils::getLocalNameIfPossible(getEnumerationValues()[i]) + "\")) {" CRLF
-			"\t\t%2 = %0::" + StringUtils::removeNonAlphaNum(getEnumerationValues()[i]) + ";" CRLF
-			"\t}";
-		}
-		szDefinition += " else {" CRLF;
-		szDefinition += "\t\t%2 = %0::Unknown;" CRLF;
-		szDefinition += "\t}" CRLF;
-		szDefinition += CRLF;
-		szDefinition += "}" CRLF CRLF;
-
-		szDefinition += ""
-		"QString %0::get%1ToString() const" CRLF
-		"{" CRLF
-		"\tswitch(%2) {" CRLF;
-
-		for(int i=0; i < getEnumerationValues().count(); ++i) {
-			szDefinition += ""
-			"\tcase " + StringUtils::removeNonAlphaNum(getEnumerationValues()[i]) + ":" CRLF
-			"\t\treturn \"" + getEnumerationValues()[i] + "\";" CRLF;
+	writer << "void " << szClassname << "::set" << szFuncName << "FromString(const QString& szValue)" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	for(int i=0; i < listValues.count(); ++i) {
+		if(i == 0) {
+			writer << "if(";
+		}else{
+			writer << CodeWriter::Unindent << "}else if(";
 		}
-		szDefinition += "\tdefault:" CRLF;
-		szDefinition += "\t\treturn \"Unknown\";" CRLF;
-		szDefinition += "\t}" CRLF;
-		szDefinition += "}" CRLF;
-
-		szDefinition = szDefinition.arg(szClassname).arg(szFuncName).arg(getVariableName());
+		writer << "(szValue == \"" << listValues[i] << "\") || szValue.endsWith(\":" << StringUtils::getLocalNameIfPossible(listValues[i]) << "\"))" << CodeWriter::BeginBlock;
+		writer << szMemberName << " = " << szClassname << "::" << StringUtils::removeNonAlphaNum(listValues[i]) << ";" << CodeWriter::EndLine;
+	}
+	if(listValues.isEmpty()) {
+		writer << szMemberName << " = " << szClassname << "::Unknown;" << CodeWriter::EndLine;
+	}else{
+		writer << CodeWriter::Unindent << "}else{" << CodeWriter::EndLine << CodeWriter::Indent;
+		writer << szMemberName << " = " << szClassname << "::Unknown;" << CodeWriter::EndLine;
+		writer << CodeWriter::EndBlock;
+	}
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndLine;
+
+	writer << "QString " << szClassname << "::get" << szFuncName << "ToString() const" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
+	writer << "switch(" << szMemberName << ")" << CodeWriter::BeginBlock;
+	for(int i=0; i < listValues.count(); ++i) {
+		writer << CodeWriter::Unindent << "case " << StringUtils::removeNonAlphaNum(listValues[i]) << ":" << CodeWriter::EndLine << CodeWriter::Indent;
+		writer << "return \"" << listValues[i] << "\";" << CodeWriter::EndLine;
 	}
-	return szDefinition;
+	writer << CodeWriter::Unindent << "default:" << CodeWriter::EndLine << CodeWriter::Indent;
+	writer << "return \"Unknown\";" << CodeWriter::EndLine;
+	writer << CodeWriter::EndBlock;
+	writer << CodeWriter::EndBlock;
 }
 
-QString SimpleType::getIsNullDefinition(const QString& szClassname) const
+void SimpleType::writeIsNullDefinition(CodeWriter& writer, const QString& szClassname) const
 {
+	writer << "bool " << szClassname << "::isNull() const" << CodeWriter::EndLine;
+	writer << CodeWriter::BeginBlock;
 	if(isEnumeration()) {
-
-		QString szDefinition = ""
-		"bool %0::isNull() const" CRLF
-		"{" CRLF
-		"\t return %1 == Unknown;" CRLF
-		"}" CRLF;
-
-		return szDefinition.arg(szClassname).arg(getVariableName());
-
-	} else {
-		QString szDefinition = ""
-		"bool %0::isNull() const" CRLF
-		"{" CRLF
-		"\t return %1.isNull();" CRLF
-		"}" CRLF;
-
-		return szDefinition.arg(szClassname).arg(getVariableName());
+		writer << "return " << getVariableName() << " == Unknown;" << CodeWriter::EndLine;
+	}else{
+		writer << "return " << getVariableName() << ".isNull();" << CodeWriter::EndLine;
 	}
+	writer << CodeWriter::EndBlock;
 }
 
 QString SimpleType::getVariableName() const
@@ -15,6 +15,8 @@
 
 #include "Type.h"
 
+class CodeWriter;
+
 class SimpleType : public Type
 {
 public:
@@ -82,10 +84,10 @@ public:
 	QString getSetterDefinitionForComplexType(const QString& szClassname) const;
 	QString getGetterDefinition(const QString& szClassname) const;
 	QString getGetterDefinitionForComplexType(const QString& szClassname) const;
-	QString getSerializerDefinition(const QString& szClassname) const;
-	QString getDeserializerDefinition(const QString& szClassname) const;
-	QString getEnumConvertDefinition(const QString& szClassname) const;
-	QString getIsNullDefinition(const QString& szClassname) const;
+	void writeSerializerDefinition(CodeWriter& writer, const QString& szClassname) const;
+	void writeDeserializerDefinition(CodeWriter& writer, const QString& szClassname) const;
+	void writeEnumConvertDefinition(CodeWriter& writer, const QString& szClassname) const;
+	void writeIsNullDefinition(CodeWriter& writer, const QString& szClassname) const;
 
 	QString getVariableDeclaration() const;
 	QString getVariableDeclarationForComplexType() const;
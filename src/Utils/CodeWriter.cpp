@@ -0,0 +1,115 @@
+/*
+ * CodeWriter.cpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#include "CodeWriter.h"
+
+#ifndef CRLF
+#define CRLF "\r\n"
+#endif
+
+CodeWriter::CodeWriter(int iReservedSize)
+{
+	m_szBuffer.reserve(iReservedSize);
+	m_iIndentLevel = 0;
+	m_bStartOfLine = true;
+}
+
+CodeWriter::~CodeWriter()
+{
+
+}
+
+CodeWriter& CodeWriter::operator<<(Token token)
+{
+	switch(token) {
+	case EndLine:
+		m_szBuffer += QLatin1String(CRLF);
+		m_bStartOfLine = true;
+		break;
+	case Indent:
+		m_iIndentLevel++;
+		break;
+	case Unindent:
+		if(m_iIndentLevel > 0){
+			m_iIndentLevel--;
+		}
+		break;
+	case BeginBlock:
+		writeIndentation();
+		m_szBuffer += QLatin1String("{" CRLF);
+		m_bStartOfLine = true;
+		m_iIndentLevel++;
+		break;
+	case EndBlock:
+		if(m_iIndentLevel > 0){
+			m_iIndentLevel--;
+		}
+		writeIndentation();
+		m_szBuffer += QLatin1String("}" CRLF);
+		m_bStartOfLine = true;
+		break;
+	}
+	return *this;
+}
+
+CodeWriter& CodeWriter::operator<<(const char* szText)
+{
+	writeIndentation();
+	// Generator literals are plain ASCII
+	m_szBuffer += QLatin1String(szText);
+	return *this;
+}
+
+CodeWriter& CodeWriter::operator<<(const QString& szText)
+{
+	writeIndentation();
+	m_szBuffer += szText;
+	return *this;
+}
+
+CodeWriter& CodeWriter::operator<<(int iValue)
+{
+	writeIndentation();
+	m_szBuffer += QString::number(iValue);
+	return *this;
+}
+
+void CodeWriter::setIndentLevel(int iIndentLevel)
+{
+	m_iIndentLevel = iIndentLevel;
+}
+
+int CodeWriter::getIndentLevel() const
+{
+	return m_iIndentLevel;
+}
+
+const QString& CodeWriter::getBuffer() const
+{
+	return m_szBuffer;
+}
+
+bool CodeWriter::isEmpty() const
+{
+	return m_szBuffer.isEmpty();
+}
+
+void CodeWriter::flush(QTextStream& os)
+{
+	os << m_szBuffer;
+	m_szBuffer.resize(0);
+	m_bStartOfLine = true;
+}
+
+void CodeWriter::writeIndentation()
+{
+	if(m_bStartOfLine){
+		for(int i = 0; i < m_iIndentLevel; ++i){
+			m_szBuffer += QLatin1Char('\t');
+		}
+		m_bStartOfLine = false;
+	}
+}
@@ -0,0 +1,55 @@
+/*
+ * CodeWriter.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef SRC_UTILS_CODEWRITER_H_
+#define SRC_UTILS_CODEWRITER_H_
+
+#include <QString>
+#include <QTextStream>
+
+/*
+ * Append generated source code to a single preallocated buffer. Indentation
+ * is written at the start of each line according to the current level, so
+ * callers only write the content of the lines.
+ */
+class CodeWriter
+{
+public:
+	enum Token {
+		EndLine,	// Terminate the current line
+		Indent,		// Increase indentation of the next lines
+		Unindent,	// Decrease indentation of the next lines
+		BeginBlock,	// Write "{", terminate the line and indent
+		EndBlock	// Unindent, write "}" and terminate the line
+	};
+
+public:
+	CodeWriter(int iReservedSize = 16*1024);
+	virtual ~CodeWriter();
+
+	CodeWriter& operator<<(Token token);
+	CodeWriter& operator<<(const char* szText);
+	CodeWriter& operator<<(const QString& szText);
+	CodeWriter& operator<<(int iValue);
+
+	void setIndentLevel(int iIndentLevel);
+	int getIndentLevel() const;
+
+	const QString& getBuffer() const;
+	bool isEmpty() const;
+
+	// Write the buffer in the stream and clear it, the allocated memory is kept
+	void flush(QTextStream& os);
+
+private:
+	void writeIndentation();
+
+	QString m_szBuffer;
+	int m_iIndentLevel;
+	bool m_bStartOfLine;
+};
+
+#endif /* SRC_UTILS_CODEWRITER_H_ */
@@ -40,4 +40,14 @@ QString ModelUtils::getCPPTypeName(const QString& szNamespace, const QString& sz
 	szTypeName += szLocalName;
 
 	return szTypeName;
-}
\ No newline at end of file
+}
+
+quint32 ModelUtils::getNameHash(const QString& szName)
+{
+	quint32 iHash = 2166136261U;
+	for(int i = 0; i < szName.size(); ++i) {
+		iHash ^= szName.at(i).unicode();
+		iHash *= 16777619U;
+	}
+	return iHash;
+}
@@ -0,0 +1,65 @@
+/*
+ * NamespaceDependencyMap.cpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#include "NamespaceDependencyMap.h"
+
+NamespaceDependencyMap::NamespaceDependencyMap()
+{
+
+}
+
+NamespaceDependencyMap::~NamespaceDependencyMap()
+{
+
+}
+
+NamespaceDependencyMapSharedPtr NamespaceDependencyMap::create()
+{
+	return NamespaceDependencyMapSharedPtr(new NamespaceDependencyMap());
+}
+
+void NamespaceDependencyMap::addNamespace(const QString& szNamespace)
+{
+	if(!contains(szNamespace)){
+		insert(szNamespace, UniqueStringList());
+	}
+}
+
+void NamespaceDependencyMap::addDependency(const QString& szNamespace, const QString& szDependency)
+{
+	if(szNamespace.isEmpty() || szDependency.isEmpty() || szNamespace == szDependency){
+		return;
+	}
+	addNamespace(szDependency);
+	(*this)[szNamespace].append(szDependency);
+}
+
+bool NamespaceDependencyMap::dependsOn(const QString& szNamespace, const QString& szDependency) const
+{
+	UniqueStringList listVisited;
+	return dependsOn(szNamespace, szDependency, listVisited);
+}
+
+bool NamespaceDependencyMap::dependsOn(const QString& szNamespace, const QString& szDependency, UniqueStringList& listVisited) const
+{
+	if(listVisited.contains(szNamespace)){
+		return false;
+	}
+	listVisited.append(szNamespace);
+
+	const_iterator iter = constFind(szNamespace);
+	if(iter == constEnd()){
+		return false;
+	}
+
+	UniqueStringList::const_iterator dependency;
+	for(dependency = iter.value().constBegin(); dependency != iter.value().constEnd(); ++dependency){
+		if(*dependency == szDependency || dependsOn(*dependency, szDependency, listVisited)){
+			return true;
+		}
+	}
+	return false;
+}
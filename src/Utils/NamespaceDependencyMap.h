@@ -0,0 +1,40 @@
+/*
+ * NamespaceDependencyMap.h
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef SRC_UTILS_NAMESPACEDEPENDENCYMAP_H_
+#define SRC_UTILS_NAMESPACEDEPENDENCYMAP_H_
+
+#include <QMap>
+#include <QSharedPointer>
+#include <QString>
+
+#include "UniqueStringList.h"
+
+class NamespaceDependencyMap;
+typedef QSharedPointer<NamespaceDependencyMap> NamespaceDependencyMapSharedPtr;
+
+/*
+ * For each namespace of the generated files, the list of namespaces its
+ * generated headers include.
+ */
+class NamespaceDependencyMap : public QMap<QString, UniqueStringList> {
+public:
+	NamespaceDependencyMap();
+	virtual ~NamespaceDependencyMap();
+
+	static NamespaceDependencyMapSharedPtr create();
+
+	void addNamespace(const QString& szNamespace);
+	void addDependency(const QString& szNamespace, const QString& szDependency);
+
+	// Return true if szDependency can be reached from szNamespace
+	bool dependsOn(const QString& szNamespace, const QString& szDependency) const;
+
+private:
+	bool dependsOn(const QString& szNamespace, const QString& szDependency, UniqueStringList& listVisited) const;
+};
+
+#endif /* SRC_UTILS_NAMESPACEDEPENDENCYMAP_H_ */
@@ -50,6 +50,15 @@ public:
 		return szName;
 	}
 
+	// Escape a value to write it in a generated C string literal
+	static inline QString escapeString(const QString& szString)
+	{
+		QString szRet = szString;
+		szRet.replace("\\", "\\\\");
+		szRet.replace("\"", "\\\"");
+		return szRet;
+	}
+
 private:
 	static inline QString replaceNonConformCharacters(const QString& szString)
 	{
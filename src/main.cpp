@@ -18,10 +18,12 @@
 #include <QCoreApplication>
 
 #include "Builder/FileBuilder.h"
+#include "Builder/GenerationReport.h"
 #include "Builder/TypeListBuilder.h"
 #include "Builder/FileHelper.h"
 
 #include "Parser/QWSDLParser.h"
+#include "Utils/NamespaceDependencyMap.h"
 #include "Utils/UniqueStringList.h"
 
 QStringList getWSDLFileNames(const char* szPathSrc);
@@ -47,6 +49,9 @@ int main(int argc, char **argv)
 	QString szNamespace;
 	QString szResourcePath = "./resources";
 	QString szServiceName;
+	QString szSerializationMode = "Default";
+	QString szReportPath;
+	QMap<QString, int> mapOperationCacheTtl;
 
 	// Parse extra args
 	for(int i=3; i<argc; i++)
@@ -64,6 +69,26 @@ int main(int argc, char **argv)
 		if(szArg.startsWith("--service-name=")){
 			szServiceName = szArg.mid((15));
 		}
+		if(szArg.startsWith("--serialization-mode=")){
+			szSerializationMode = szArg.mid(21);
+		}
+		if(szArg.startsWith("--report=")){
+			szReportPath = szArg.mid(9);
+		}
+		if(szArg.startsWith("--cache-ttl=")){
+			QStringList listOperationTtl = szArg.mid(12).split(',');
+			QStringList::const_iterator iterTtl;
+			for(iterTtl = listOperationTtl.constBegin(); iterTtl != listOperationTtl.constEnd(); ++iterTtl) {
+				QString szOperation = iterTtl->section(':', 0, 0);
+				bool bOk = false;
+				int iTtl = iterTtl->section(':', 1, 1).toInt(&bOk);
+				if(szOperation.isEmpty() || !bOk){
+					bShowHelp = true;
+				}else{
+					mapOperationCacheTtl.insert(szOperation, iTtl);
+				}
+			}
+		}
 	}
 
 	if(szNamespace.isEmpty()){
@@ -73,9 +98,12 @@ int main(int argc, char **argv)
 	if(bShowHelp){
 		printf("Usage: ./jet1oeil-soapero SRC_DIR DST_DIR\r\n");
 		printf("       --namespace=[NAMESPACE]: Global namespace to use for generated class (Mandatory)\r\n");
-		printf("       --output-mode=[OUTPUT_MODE]: \"Default\" or \"CMakeLists\"\r\n");
+		printf("       --output-mode=[OUTPUT_MODE]: \"Default\", \"CMakeLists\", \"CMakeListsObjectLibraries\" (one object library per namespace) or \"CMakeListsModules\" (one C++20 module per namespace)\r\n");
 		printf("       --resources-dir=[DIR]: Path where to find resources files. Used to copy some files in output directory. (Default: ./resources)\r\n");
 		printf("       --service-name=[SERVICE_NAME]: Force service name, useful for wsdl service not defining the name tag.\r\n");
+		printf("       --serialization-mode=[MODE]: \"Default\" or \"Table\" (serialization driven by static field descriptor tables)\r\n");
+		printf("       --report=[FILE]: Write the size and compile cost of each generated type, in CSV if FILE ends with .csv, in JSON otherwise\r\n");
+		printf("       --cache-ttl=[OPERATION:TTL,...]: Time to live in milliseconds of the cached responses of read-only operations, used when a response cache is set on the service\r\n");
 		return -1;
 	}
 
@@ -90,6 +118,11 @@ int main(int argc, char **argv)
 
 	// Loading list of WSDL files
 	QSharedPointer<UniqueStringList> pListGeneratedFiles(new UniqueStringList());
+	NamespaceDependencyMapSharedPtr pNamespaceDependencyMap = NamespaceDependencyMap::create();
+	GenerationReportSharedPtr pGenerationReport;
+	if(!szReportPath.isEmpty()){
+		pGenerationReport = GenerationReport::create();
+	}
 	QStringList listWSDLFileNames = getWSDLFileNames(szWSDLFilesDirectory);
 	qDebug("[Main] %d WSDL files have been found in directory '%s'", (int)listWSDLFileNames.count(), szWSDLFilesDirectory);
 
@@ -158,6 +191,15 @@ int main(int argc, char **argv)
 				builder.setNamespace(szNamespace);
 				builder.setFilename("actionservice");
 				builder.setDirname(szOutputDirectory);
+				builder.setNamespaceDependencyMap(pNamespaceDependencyMap);
+				builder.setGenerationReport(pGenerationReport);
+				builder.setOperationCacheTtlMap(mapOperationCacheTtl);
+				if(szOutputMode == "CMakeListsModules"){
+					builder.setModuleOutput(true);
+				}
+				if(szSerializationMode == "Table"){
+					builder.setSerializationMode(TypeListBuilder::SerializationMode_Table);
+				}
 				builder.buildHeaderFiles();
 				builder.buildCppFiles();
 
@@ -251,11 +293,26 @@ int main(int argc, char **argv)
 		FileBuilder::FileType fileType = FileBuilder::Default;
 		if(szOutputMode == "CMakeLists"){
 			fileType = FileBuilder::CMakeLists;
+		}else if(szOutputMode == "CMakeListsObjectLibraries"){
+			fileType = FileBuilder::CMakeListsObjectLibraries;
+		}else if(szOutputMode == "CMakeListsModules"){
+			fileType = FileBuilder::CMakeListsModules;
 		}
 		FileBuilder* pFileBuilder = FileBuilder::createFileBuilderFromType(fileType, szNamespace, szOutputDirectory, pListGeneratedFiles);
 		if(pFileBuilder){
+			pFileBuilder->setNamespaceDependencyMap(pNamespaceDependencyMap);
 			pFileBuilder->generateFile();
 		}
+
+		if(pGenerationReport){
+			GenerationReport::Format iFormat = GenerationReport::Format_JSON;
+			if(szReportPath.endsWith(".csv", Qt::CaseInsensitive)){
+				iFormat = GenerationReport::Format_CSV;
+			}
+			if(pGenerationReport->generateFile(szOutputDirectory, szReportPath, iFormat)){
+				qDebug("[Main] Generation report written in '%s'", qPrintable(szReportPath));
+			}
+		}
 	}
 
 	return iRes;